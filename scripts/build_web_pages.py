@@ -0,0 +1,67 @@
+# Minifies and gzips src/web/*.html into headers that are served gzip compressed.
+# Runs as a PlatformIO pre script, but can also be started on its own with python.
+
+import glob
+import gzip
+import hashlib
+import os
+import re
+
+try:
+    Import("env")
+    PROJECT_DIR = env["PROJECT_DIR"]
+except NameError:
+    PROJECT_DIR = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..")
+
+WEB_DIR = os.path.join(PROJECT_DIR, "src", "web")
+BYTES_PER_LINE = 16
+
+
+def minify(html):
+    html = re.sub(r"<!--.*?-->", "", html, flags=re.DOTALL)
+    # Line breaks are kept so that inline scripts without semicolons still work
+    lines = [line.strip() for line in html.splitlines()]
+    return "\n".join(line for line in lines if line)
+
+
+def variable_name(path):
+    name = os.path.splitext(os.path.basename(path))[0]
+    return name[0].lower() + name[1:]
+
+
+def generate_header(html_path):
+    with open(html_path, "r", encoding="utf-8") as f:
+        html = f.read()
+
+    # mtime is fixed so that unchanged pages produce identical output and ETags
+    compressed = gzip.compress(minify(html).encode("utf-8"), compresslevel=9, mtime=0)
+    etag = hashlib.sha1(compressed).hexdigest()[:16]
+    name = variable_name(html_path)
+
+    lines = [
+        "// Generated by scripts/build_web_pages.py from " + os.path.basename(html_path) + ", do not edit!",
+        "#include <Arduino.h>",
+        "",
+        "const char %sEtag[] = \"\\\"%s\\\"\";" % (name, etag),
+        "const size_t %sLength = %d;" % (name, len(compressed)),
+        "const uint8_t %s[] PROGMEM = {" % name,
+    ]
+    for i in range(0, len(compressed), BYTES_PER_LINE):
+        chunk = compressed[i:i + BYTES_PER_LINE]
+        lines.append("    " + ", ".join("0x%02x" % b for b in chunk) + ",")
+    lines.append("};")
+    content = "\n".join(lines) + "\n"
+
+    header_path = os.path.splitext(html_path)[0] + ".h"
+    if os.path.exists(header_path):
+        with open(header_path, "r", encoding="utf-8") as f:
+            if f.read() == content:
+                return
+
+    with open(header_path, "w", encoding="utf-8") as f:
+        f.write(content)
+    print("Generated %s (%d bytes -> %d bytes gzipped)" % (os.path.basename(header_path), len(html), len(compressed)))
+
+
+for html_path in sorted(glob.glob(os.path.join(WEB_DIR, "*.html"))):
+    generate_header(html_path)
@@ -0,0 +1,193 @@
+# End-to-end check of the MQTT backend: subscribes to the topics of a thermometer on a broker and verifies what it
+# published. The values are retained, so a thermometer that reported before is checked right away even while it
+# sleeps. With --fresh it also waits for the next report, which must not be flagged as retained.
+# Speaks MQTT 3.1.1 itself, so it needs nothing but Python. A broker to test against is started with:
+#
+#   docker run --rm -p 1883:1883 -v "$PWD/scripts/mosquitto.conf:/mosquitto/config/mosquitto.conf" eclipse-mosquitto:2
+#   python scripts/mqtt_check.py --name garden [--broker localhost] [--battery] [--fresh] [--timeout 60]
+#
+# Exits with 1 if a value is missing or invalid.
+
+import argparse
+import json
+import socket
+import struct
+import sys
+import time
+
+CONNECT = 0x10
+CONNACK = 0x20
+PUBLISH = 0x30
+PUBACK = 0x40
+SUBSCRIBE = 0x82
+SUBACK = 0x90
+PINGREQ = 0xC0
+KEEP_ALIVE_SECS = 60
+DIAGNOSTICS_KEYS = ["rssi", "awakeMs", "wifiMs", "freeHeap", "probes", "queuedReports", "timings"]
+
+
+def encode_string(text):
+    data = text.encode("utf-8")
+    return struct.pack(">H", len(data)) + data
+
+
+def encode_packet(kind, body):
+    length = b""
+    remaining = len(body)
+    while True:
+        byte = remaining % 128
+        remaining //= 128
+        length += bytes([byte | 0x80 if remaining > 0 else byte])
+        if remaining == 0:
+            return bytes([kind]) + length + body
+
+
+class Client:
+    def __init__(self, args):
+        self.sock = socket.create_connection((args.broker, args.port), timeout=10)
+        flags = 0x02
+        payload = encode_string("thermometer-check-%d" % (time.time() * 1000 % 1000000))
+        if args.user:
+            flags |= 0x80
+            payload += encode_string(args.user)
+            if args.password:
+                flags |= 0x40
+                payload += encode_string(args.password)
+        self.sock.sendall(encode_packet(CONNECT, encode_string("MQTT") + struct.pack(">BBH", 4, flags, KEEP_ALIVE_SECS) + payload))
+
+        kind, body = self.read_packet()
+        if kind != CONNACK or body[1] != 0:
+            raise ConnectionRefusedError("broker refused the connection with code %d" % body[1])
+        self.last_sent = time.monotonic()
+
+    def read_exactly(self, length):
+        data = b""
+        while len(data) < length:
+            chunk = self.sock.recv(length - len(data))
+            if not chunk:
+                raise ConnectionResetError("closed by the broker")
+            data += chunk
+        return data
+
+    def read_packet(self):
+        kind = self.read_exactly(1)[0]
+        length = 0
+        for shift in range(0, 28, 7):
+            byte = self.read_exactly(1)[0]
+            length |= (byte & 0x7F) << shift
+            if byte & 0x80 == 0:
+                break
+        return kind, self.read_exactly(length)
+
+    def subscribe(self, topic_filter):
+        self.sock.sendall(encode_packet(SUBSCRIBE, struct.pack(">H", 1) + encode_string(topic_filter) + b"\x01"))
+
+    # Returns (topic, payload, retained, qos) or None when the timeout passed without a message
+    def next_message(self, timeout):
+        deadline = time.monotonic() + timeout
+        while time.monotonic() < deadline:
+            if time.monotonic() - self.last_sent > KEEP_ALIVE_SECS / 2:
+                self.sock.sendall(bytes([PINGREQ, 0]))
+                self.last_sent = time.monotonic()
+            self.sock.settimeout(max(0.1, min(deadline - time.monotonic(), KEEP_ALIVE_SECS / 2)))
+            try:
+                kind, body = self.read_packet()
+            except socket.timeout:
+                continue
+            if kind & 0xF0 != PUBLISH:
+                continue
+
+            qos = kind >> 1 & 0x03
+            topic_length = struct.unpack_from(">H", body)[0]
+            topic = body[2 : 2 + topic_length].decode("utf-8")
+            offset = 2 + topic_length
+            if qos > 0:
+                self.sock.sendall(encode_packet(PUBACK, body[offset : offset + 2]))
+                offset += 2
+            return topic, body[offset:].decode("utf-8", errors="replace"), bool(kind & 0x01), qos
+        return None
+
+
+def check_number(problems, label, payload, low, high):
+    try:
+        value = float(payload)
+    except ValueError:
+        problems.append("%s is not a number: %r" % (label, payload))
+        return
+    if not low <= value <= high:
+        problems.append("%s %.3f is outside %g to %g" % (label, value, low, high))
+
+
+def check_diagnostics(problems, payload):
+    try:
+        diagnostics = json.loads(payload)
+    except ValueError:
+        problems.append("diagnostics are no JSON: %r" % payload[:80])
+        return
+    missing = [key for key in DIAGNOSTICS_KEYS if key not in diagnostics]
+    if missing:
+        problems.append("diagnostics lack %s" % ", ".join(missing))
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Checks the retained MQTT values of a thermometer on a broker.")
+    parser.add_argument("--name", required=True, help="name of the thermometer, part of the default topics")
+    parser.add_argument("--broker", default="localhost")
+    parser.add_argument("--port", type=int, default=1883)
+    parser.add_argument("--user")
+    parser.add_argument("--password")
+    parser.add_argument("--topic-temp", help="default thermometer/<name>/temperature")
+    parser.add_argument("--topic-battery", help="default thermometer/<name>/battery")
+    parser.add_argument("--topic-diagnostics", help="default thermometer/<name>/diagnostics")
+    parser.add_argument("--battery", action="store_true", help="the battery level is reported as well")
+    parser.add_argument("--fresh", action="store_true", help="also wait for the next report of the temperature")
+    parser.add_argument("--timeout", type=float, default=60.0, help="seconds to wait for the values")
+    args = parser.parse_args()
+
+    topic_temp = args.topic_temp or "thermometer/%s/temperature" % args.name
+    topic_battery = args.topic_battery or "thermometer/%s/battery" % args.name
+    topic_diagnostics = args.topic_diagnostics or "thermometer/%s/diagnostics" % args.name
+    expected = [topic_temp, topic_diagnostics] + ([topic_battery] if args.battery else [])
+
+    client = Client(args)
+    # Probes publish below the temperature topic
+    for topic_filter in sorted(set([topic_temp, topic_temp + "/+", topic_battery, topic_diagnostics])):
+        client.subscribe(topic_filter)
+
+    received = {}
+    fresh_at = None
+    start = time.monotonic()
+    while time.monotonic() - start < args.timeout:
+        if all(topic in received for topic in expected) and (not args.fresh or fresh_at is not None):
+            break
+        message = client.next_message(args.timeout - (time.monotonic() - start))
+        if message is None:
+            break
+        topic, payload, retained, qos = message
+        received[topic] = payload
+        print("%-48s %-8s qos %d  %s" % (topic, "retained" if retained else "new", qos, payload[:120]), flush=True)
+        if topic == topic_temp and not retained and fresh_at is None:
+            fresh_at = time.monotonic() - start
+
+    problems = ["nothing received on %s" % topic for topic in expected if topic not in received]
+    if args.fresh and fresh_at is None:
+        problems.append("no new report on %s within %.0f s" % (topic_temp, args.timeout))
+    for topic, payload in sorted(received.items()):
+        if topic == topic_temp or topic.startswith(topic_temp + "/"):
+            check_number(problems, topic, payload, -55.0, 125.0)
+        elif topic == topic_battery:
+            check_number(problems, topic, payload, 0.0, 1.0)
+        elif topic == topic_diagnostics:
+            check_diagnostics(problems, payload)
+
+    probes = len([topic for topic in received if topic.startswith(topic_temp + "/")])
+    print("Probes: %d, new report after: %s" % (probes, "%.1f s" % fresh_at if fresh_at is not None else "-"))
+    for problem in problems:
+        print("FAILED: %s" % problem)
+    if not problems:
+        print("OK")
+    sys.exit(1 if problems else 0)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,106 @@
+# Receives the datagrams of thermometers using the UDP multicast backend and prints one line per reading.
+# The layout is described in src/ReadingDatagram.h. Sequence gaps per sensor are counted as lost datagrams.
+#
+#   python scripts/multicast_collector.py [--group 239.255.42.42] [--port 4242]
+
+import argparse
+import datetime
+import socket
+import struct
+
+MAGIC = b"TH"
+VERSION = 1
+LENGTH_HEADER = 16
+FLAG_TEMP = 0x01
+FLAG_BATTERY = 0x02
+NO_TEMP = -32768
+
+
+def crc16(data):
+    crc = 0xFFFF
+    for byte in data:
+        crc ^= byte << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) & 0xFFFF if crc & 0x8000 else (crc << 1) & 0xFFFF
+    return crc
+
+
+def decode(data):
+    if len(data) < LENGTH_HEADER + 3 or data[:2] != MAGIC or not 0 < data[2] <= VERSION:
+        return None
+    if struct.unpack_from("<H", data, len(data) - 2)[0] != crc16(data[:-2]):
+        return None
+
+    flags, sequence, time, temp, battery, rssi, name_length = struct.unpack_from("<BHIhhbB", data, 3)
+    probes_at = LENGTH_HEADER + name_length
+    if probes_at + 3 > len(data):
+        return None
+    probe_count = data[probes_at]
+    if probes_at + 1 + probe_count * 2 + 2 != len(data):
+        return None
+    probes = struct.unpack_from("<%dh" % probe_count, data, probes_at + 1)
+
+    return {
+        "sequence": sequence,
+        "time": time,
+        "name": data[LENGTH_HEADER:probes_at].decode("utf-8", "replace"),
+        "temp": temp / 100.0 if flags & FLAG_TEMP and temp != NO_TEMP else None,
+        "battery": battery / 1000.0 if flags & FLAG_BATTERY else None,
+        "rssi": rssi,
+        "probes": [probe / 100.0 if probe != NO_TEMP else None for probe in probes],
+    }
+
+
+def open_socket(group, port):
+    sock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM, socket.IPPROTO_UDP)
+    sock.setsockopt(socket.SOL_SOCKET, socket.SO_REUSEADDR, 1)
+    sock.bind(("", port))
+    membership = struct.pack("4s4s", socket.inet_aton(group), socket.inet_aton("0.0.0.0"))
+    sock.setsockopt(socket.IPPROTO_IP, socket.IP_ADD_MEMBERSHIP, membership)
+    return sock
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Collects thermometer readings sent to a UDP multicast group.")
+    parser.add_argument("--group", default="239.255.42.42")
+    parser.add_argument("--port", type=int, default=4242)
+    args = parser.parse_args()
+
+    sock = open_socket(args.group, args.port)
+    last_sequences = {}
+    lost = {}
+    invalid = 0
+
+    while True:
+        data, (address, _) = sock.recvfrom(512)
+        reading = decode(data)
+        if reading is None:
+            invalid += 1
+            print("Invalid datagram from %s (%d so far)" % (address, invalid))
+            continue
+
+        # The sequence restarts at 0 after a power loss, which is not counted as loss
+        name = reading["name"]
+        last = last_sequences.get(name)
+        if last is not None and reading["sequence"] != 0:
+            lost[name] = lost.get(name, 0) + (reading["sequence"] - last - 1) % 65536
+        last_sequences[name] = reading["sequence"]
+
+        time = datetime.datetime.fromtimestamp(reading["time"]).isoformat() if reading["time"] > 0 else "-"
+        print(
+            "%s %s seq=%d temp=%s battery=%s rssi=%d probes=%s lost=%d"
+            % (
+                time,
+                name,
+                reading["sequence"],
+                reading["temp"],
+                reading["battery"],
+                reading["rssi"],
+                reading["probes"],
+                lost.get(name, 0),
+            )
+        )
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,140 @@
+# Sends datagrams of many simulated thermometers to a multicast group on the loopback interface and receives them
+# with the decoder of multicast_collector.py, to measure the datagrams lost and the CPU time of the collector at high
+# sender counts. The senders run in their own processes, so they do not take CPU time from the receiver.
+#
+#   python scripts/multicast_loopback.py [--senders 500] [--rate 2] [--duration 10] [--processes 4]
+
+import argparse
+import multiprocessing
+import os
+import resource
+import socket
+import struct
+import sys
+import time
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+from multicast_collector import FLAG_BATTERY, FLAG_TEMP, MAGIC, VERSION, crc16, decode  # noqa: E402
+
+# Time the receiver keeps listening after the senders are done
+DRAIN_SECONDS = 0.5
+
+
+def encode(sequence, name, temp, battery, probes):
+    encoded_name = name.encode("utf-8")
+    data = MAGIC + struct.pack(
+        "<BBHIhhbB",
+        VERSION,
+        FLAG_TEMP | FLAG_BATTERY,
+        sequence,
+        int(time.time()),
+        round(temp * 100),
+        round(battery * 1000),
+        -60,
+        len(encoded_name),
+    )
+    data += encoded_name + struct.pack("<B%dh" % len(probes), len(probes), *[round(probe * 100) for probe in probes])
+    return data + struct.pack("<H", crc16(data))
+
+
+def run_senders(index, names, args, sent):
+    sock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM, socket.IPPROTO_UDP)
+    sock.setsockopt(socket.IPPROTO_IP, socket.IP_MULTICAST_IF, socket.inet_aton(args.interface))
+    sock.setsockopt(socket.IPPROTO_IP, socket.IP_MULTICAST_LOOP, 1)
+
+    # Encoded before, so the senders only spend time on sending. The sequence numbers repeat after 16 datagrams.
+    datagrams = [[encode(sequence, name, 21.5, 0.9, [20.0] * args.probes) for sequence in range(16)] for name in names]
+    interval = 1.0 / (len(names) * args.rate)
+    count = 0
+    start = time.monotonic()
+    while time.monotonic() - start < args.duration:
+        sock.sendto(datagrams[count % len(names)][count // len(names) % 16], (args.group, args.port))
+        count += 1
+        delay = start + count * interval - time.monotonic()
+        if delay > 0:
+            time.sleep(delay)
+    sent.put((index, count))
+
+
+def open_receiver(args):
+    sock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM, socket.IPPROTO_UDP)
+    sock.setsockopt(socket.SOL_SOCKET, socket.SO_REUSEADDR, 1)
+    if args.receive_buffer > 0:
+        sock.setsockopt(socket.SOL_SOCKET, socket.SO_RCVBUF, args.receive_buffer)
+    sock.bind(("", args.port))
+    membership = struct.pack("4s4s", socket.inet_aton(args.group), socket.inet_aton(args.interface))
+    sock.setsockopt(socket.IPPROTO_IP, socket.IP_ADD_MEMBERSHIP, membership)
+    sock.settimeout(DRAIN_SECONDS)
+    return sock
+
+
+def cpu_seconds(who):
+    usage = resource.getrusage(who)
+    return usage.ru_utime + usage.ru_stime
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Measures datagram loss and collector CPU time on the loopback interface.")
+    parser.add_argument("--senders", type=int, default=500, help="simulated thermometers")
+    parser.add_argument("--rate", type=float, default=2.0, help="datagrams per second of each thermometer")
+    parser.add_argument("--duration", type=float, default=10.0, help="seconds of sending")
+    parser.add_argument("--processes", type=int, default=4, help="processes the thermometers are spread over")
+    parser.add_argument("--probes", type=int, default=2)
+    parser.add_argument("--group", default="239.255.42.42")
+    parser.add_argument("--port", type=int, default=4243)
+    parser.add_argument("--interface", default="127.0.0.1")
+    parser.add_argument("--receive-buffer", type=int, default=0, help="SO_RCVBUF in bytes, 0 keeps the default")
+    args = parser.parse_args()
+
+    sock = open_receiver(args)
+    names = ["loop-%04d" % i for i in range(args.senders)]
+    sent = multiprocessing.Queue()
+    processes = [
+        multiprocessing.Process(target=run_senders, args=(i, names[i :: args.processes], args, sent))
+        for i in range(args.processes)
+    ]
+    for process in processes:
+        process.start()
+
+    received = {}
+    invalid = 0
+    receive_start = cpu_seconds(resource.RUSAGE_SELF)
+    deadline = time.monotonic() + args.duration + DRAIN_SECONDS
+    while True:
+        try:
+            data, _ = sock.recvfrom(512)
+        except socket.timeout:
+            if time.monotonic() > deadline:
+                break
+            continue
+
+        reading = decode(data)
+        if reading is None:
+            invalid += 1
+        else:
+            received[reading["name"]] = received.get(reading["name"], 0) + 1
+    receive_cpu = cpu_seconds(resource.RUSAGE_SELF) - receive_start
+
+    for process in processes:
+        process.join()
+    total_sent = sum(sent.get()[1] for _ in processes)
+    total_received = sum(received.values())
+    lost = total_sent - total_received
+
+    print("Senders:    %d in %d processes, %.1f datagrams/s each" % (args.senders, args.processes, args.rate))
+    print("Sent:       %d datagrams, %.0f/s" % (total_sent, total_sent / args.duration))
+    print("Received:   %d valid, %d invalid, from %d senders" % (total_received, invalid, len(received)))
+    print("Lost:       %d (%.3f %%)" % (lost, 100.0 * lost / total_sent if total_sent > 0 else 0.0))
+    print(
+        "Collector:  %.2f s CPU, %.1f us per datagram, %.1f %% of one core"
+        % (
+            receive_cpu,
+            1e6 * receive_cpu / total_received if total_received > 0 else 0.0,
+            100.0 * receive_cpu / (args.duration + DRAIN_SECONDS),
+        )
+    )
+    print("Senders:    %.2f s CPU" % cpu_seconds(resource.RUSAGE_CHILDREN))
+
+
+if __name__ == "__main__":
+    main()
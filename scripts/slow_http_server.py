@@ -0,0 +1,194 @@
+# Stand-in for a report server that misbehaves, to test the deadlines of the asynchronous HTTP client.
+# Every connection is answered in one of the modes below, a list of modes is used in turn per connection.
+# For each connection it prints how long the client kept it open, so the connect and total deadlines show up
+# as the time until the client gave up.
+#
+#   python scripts/slow_http_server.py [--port 8080] [--mode ok,slow,blackhole] [--delay 5]
+#
+# Used as the report and diagnostics address of a thermometer it also prints the awake time and the PUT phases
+# from every diagnostics report, with their median per mode. Comparing the modes ok and keepalive over some wakes
+# shows what reusing the connection saves per cycle.
+#
+# A connect that never completes cannot be served from here, use an address without a host instead,
+# for example http://10.255.255.1/ in the report settings.
+
+import argparse
+import itertools
+import json
+import socket
+import socketserver
+import threading
+import time
+
+MODES = {
+    "ok": "answers right away and closes the connection",
+    "keepalive": "answers right away and keeps the connection open for further requests",
+    "slow": "reads the request and answers after the delay",
+    "headers": "sends the status line, then one header line per delay and never finishes",
+    "body": "sends the headers with a content length and trickles the body one byte per delay",
+    "blackhole": "reads the request and never answers",
+    "close": "closes the connection without an answer",
+}
+
+RESPONSE_BODY = b"OK"
+# Phases of the diagnostics that show the cost of the connections
+DIAGNOSTICS_PHASES = ["putTemperature", "putBattery"]
+
+
+class Handler(socketserver.BaseRequestHandler):
+    def handle(self):
+        mode = self.mode = next(self.server.modes)
+        start = time.monotonic()
+        self.request.settimeout(self.server.delay)
+        self.buffer = b""
+        requests = 0
+        try:
+            if mode == "keepalive":
+                while self.read_request():
+                    requests += 1
+                    self.respond(keep_alive=True)
+                outcome = "closed by client"
+            else:
+                if mode != "close":
+                    if not self.read_request():
+                        raise ConnectionResetError()
+                    requests += 1
+                self.serve(mode)
+                outcome = "closed by server" if mode == "close" else "served"
+        except (socket.timeout, TimeoutError):
+            outcome = "timed out"
+        except OSError:
+            outcome = "closed by client"
+
+        elapsed = time.monotonic() - start
+        self.server.record(self.client_address[0], mode, outcome, elapsed, requests)
+
+    # Returns False if the client closed the connection before a new request
+    def read_request(self):
+        while b"\r\n\r\n" not in self.buffer:
+            chunk = self.request.recv(1024)
+            if not chunk:
+                if self.buffer:
+                    raise ConnectionResetError()
+                return False
+            self.buffer += chunk
+
+        head, self.buffer = self.buffer.split(b"\r\n\r\n", 1)
+        length = 0
+        for line in head.split(b"\r\n")[1:]:
+            name, _, value = line.partition(b":")
+            if name.strip().lower() == b"content-length":
+                length = int(value.strip())
+        while len(self.buffer) < length:
+            chunk = self.request.recv(1024)
+            if not chunk:
+                raise ConnectionResetError()
+            self.buffer += chunk
+
+        body, self.buffer = self.buffer[:length], self.buffer[length:]
+        self.server.record_diagnostics(self.mode, body)
+        return True
+
+    def serve(self, mode):
+        if mode == "ok":
+            self.respond()
+        elif mode == "slow":
+            time.sleep(self.server.delay)
+            self.respond()
+        elif mode == "headers":
+            self.request.sendall(b"HTTP/1.1 200 OK\r\n")
+            for index in itertools.count():
+                self.wait_for_hangup()
+                self.request.sendall(b"X-Slow-%d: 1\r\n" % index)
+        elif mode == "body":
+            self.request.sendall(b"HTTP/1.1 200 OK\r\nContent-Length: 1000000\r\nConnection: close\r\n\r\n")
+            while True:
+                self.wait_for_hangup()
+                self.request.sendall(b".")
+        elif mode == "blackhole":
+            while True:
+                self.wait_for_hangup()
+        elif mode == "close":
+            self.request.shutdown(socket.SHUT_RDWR)
+
+    def respond(self, keep_alive=False):
+        self.request.sendall(
+            b"HTTP/1.1 200 OK\r\nContent-Type: text/plain\r\nContent-Length: %d\r\nConnection: %s\r\n\r\n%s"
+            % (len(RESPONSE_BODY), b"keep-alive" if keep_alive else b"close", RESPONSE_BODY)
+        )
+
+    # Waits one delay and notices when the client gave up in the meantime
+    def wait_for_hangup(self):
+        try:
+            if not self.request.recv(1024):
+                raise ConnectionResetError()
+        except socket.timeout:
+            pass
+
+
+class Server(socketserver.ThreadingTCPServer):
+    allow_reuse_address = True
+    daemon_threads = True
+
+    def __init__(self, address, modes, delay):
+        super().__init__(address, Handler)
+        self.modes = itertools.cycle(modes)
+        self.delay = delay
+        self.lock = threading.Lock()
+        self.durations = []
+        self.awake = {}
+
+    def record(self, client, mode, outcome, elapsed, requests):
+        with self.lock:
+            self.durations.append(elapsed)
+            durations = sorted(self.durations)
+        print(
+            "%s %-9s %-16s %6.2f s %3d requests  (n=%d median=%.2f s max=%.2f s)"
+            % (client, mode, outcome, elapsed, requests, len(durations), durations[len(durations) // 2], durations[-1]),
+            flush=True,
+        )
+
+    # Diagnostics are the JSON bodies with an awake time, everything else is a plain value
+    def record_diagnostics(self, mode, body):
+        try:
+            diagnostics = json.loads(body)
+        except ValueError:
+            return
+        if not isinstance(diagnostics, dict) or "awakeMs" not in diagnostics:
+            return
+
+        timings = diagnostics.get("timings", {})
+        phases = ["%s %s ms" % (phase, timings[phase]["last"]) for phase in DIAGNOSTICS_PHASES if phase in timings]
+        with self.lock:
+            awake = self.awake.setdefault(mode, [])
+            awake.append(diagnostics["awakeMs"])
+            median = sorted(awake)[len(awake) // 2]
+        print(
+            "  diagnostics: awake %d ms, %s  (%s n=%d median=%d ms)"
+            % (diagnostics["awakeMs"], ", ".join(phases) or "no timings", mode, len(awake), median),
+            flush=True,
+        )
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Misbehaving HTTP server for testing report deadlines.",
+        epilog="Modes: " + "; ".join("%s %s" % item for item in MODES.items()),
+    )
+    parser.add_argument("--port", type=int, default=8080)
+    parser.add_argument("--mode", default="blackhole", help="comma separated modes, used in turn per connection")
+    parser.add_argument("--delay", type=float, default=5.0, help="seconds of the slow modes")
+    args = parser.parse_args()
+
+    modes = args.mode.split(",")
+    for mode in modes:
+        if mode not in MODES:
+            parser.error("unknown mode %s" % mode)
+
+    server = Server(("", args.port), modes, args.delay)
+    print("Listening on port %d, modes %s" % (args.port, ", ".join(modes)), flush=True)
+    server.serve_forever()
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,142 @@
+# Opens a growing number of subscribers to the live readings on /events of a thermometer in active mode and reads
+# its /metrics before, during and after each step. Prints per step how many subscribers got connected, the events
+# they received, the free heap and what the broadcasts cost the sampling task, which sends them.
+#
+#   python scripts/sse_load.py --host thermometer-garden.local [--steps 0,1,4,8,16] [--duration 30]
+#
+# The CPU share is the time of the sampling iterations per wall clock time from the loop duration histogram, so it
+# covers the broadcasts but not the work of the AsyncTCP task. The heap after closing shows whether clients leak.
+
+import argparse
+import re
+import socket
+import threading
+import time
+import urllib.request
+
+# Time the web server gets to free closed subscribers before the heap is read again
+SETTLE_SECONDS = 3.0
+METRIC_PATTERN = re.compile(r"^(\w+)(?:\{[^}]*\})? (\S+)$")
+
+
+class Subscriber(threading.Thread):
+    def __init__(self, host, port):
+        super().__init__(daemon=True)
+        self.host = host
+        self.port = port
+        self.connected = False
+        self.events = 0
+        self.error = None
+        self.stopped = threading.Event()
+        self.sock = None
+
+    def run(self):
+        try:
+            self.sock = socket.create_connection((self.host, self.port), timeout=5.0)
+            self.sock.sendall(
+                b"GET /events HTTP/1.1\r\nHost: %s\r\nAccept: text/event-stream\r\n\r\n" % self.host.encode()
+            )
+            self.sock.settimeout(1.0)
+            data = b""
+            while not self.stopped.is_set():
+                try:
+                    chunk = self.sock.recv(1024)
+                except socket.timeout:
+                    continue
+                if not chunk:
+                    raise ConnectionResetError("closed by the thermometer")
+                data += chunk
+                if not self.connected and b"\r\n\r\n" in data:
+                    self.connected = data.startswith(b"HTTP/1.1 200")
+                    if not self.connected:
+                        raise ConnectionRefusedError(data.split(b"\r\n")[0].decode(errors="replace"))
+                # Events end with an empty line
+                while b"\n\n" in data:
+                    event, data = data.split(b"\n\n", 1)
+                    if b"event: temperature" in event:
+                        self.events += 1
+        except OSError as error:
+            if not self.stopped.is_set():
+                self.error = str(error) or type(error).__name__
+        finally:
+            if self.sock is not None:
+                self.sock.close()
+
+    def stop(self):
+        self.stopped.set()
+
+
+def read_metrics(host, port):
+    start = time.monotonic()
+    with urllib.request.urlopen("http://%s:%d/metrics" % (host, port), timeout=10) as response:
+        text = response.read().decode()
+    elapsed = time.monotonic() - start
+
+    values = {}
+    for line in text.splitlines():
+        match = METRIC_PATTERN.match(line)
+        if match:
+            values[match.group(1)] = float(match.group(2))
+    values["scrape_seconds"] = elapsed
+    values["time"] = time.monotonic()
+    return values
+
+
+def run_step(args, count):
+    before = read_metrics(args.host, args.port)
+    subscribers = [Subscriber(args.host, args.port) for _ in range(count)]
+    for subscriber in subscribers:
+        subscriber.start()
+        time.sleep(args.connect_interval)
+
+    time.sleep(args.duration)
+    during = read_metrics(args.host, args.port)
+
+    for subscriber in subscribers:
+        subscriber.stop()
+    for subscriber in subscribers:
+        subscriber.join()
+    time.sleep(SETTLE_SECONDS)
+    after = read_metrics(args.host, args.port)
+
+    loops = during["thermometer_loop_duration_seconds_count"] - before["thermometer_loop_duration_seconds_count"]
+    busy = during["thermometer_loop_duration_seconds_sum"] - before["thermometer_loop_duration_seconds_sum"]
+    connected = [subscriber for subscriber in subscribers if subscriber.connected]
+    errors = sorted(set(subscriber.error for subscriber in subscribers if subscriber.error))
+    events = [subscriber.events for subscriber in connected]
+
+    print(
+        "%4d %9d %8s %10d %10d %10d %9.2f %8.2f %9.0f"
+        % (
+            count,
+            len(connected),
+            "%d-%d" % (min(events), max(events)) if events else "-",
+            during["thermometer_heap_free_bytes"],
+            during["thermometer_heap_min_free_bytes"],
+            after["thermometer_heap_free_bytes"],
+            1000.0 * busy / loops if loops > 0 else 0.0,
+            100.0 * busy / (during["time"] - before["time"]),
+            1000.0 * during["scrape_seconds"],
+        ),
+        flush=True,
+    )
+    for error in errors:
+        print("     error: %s" % error, flush=True)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Load test of the live readings with many subscribers.")
+    parser.add_argument("--host", required=True, help="address of a thermometer in active mode")
+    parser.add_argument("--port", type=int, default=80)
+    parser.add_argument("--steps", default="0,1,4,8,16", help="comma separated numbers of subscribers")
+    parser.add_argument("--duration", type=float, default=30.0, help="seconds each step is held")
+    parser.add_argument("--connect-interval", type=float, default=0.2, help="seconds between opening subscribers")
+    args = parser.parse_args()
+
+    print("subs connected   events  heap free   min free heap after loop ms    cpu %  scrape ms", flush=True)
+    for count in [int(step) for step in args.steps.split(",")]:
+        run_step(args, count)
+
+
+if __name__ == "__main__":
+    main()
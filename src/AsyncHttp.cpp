@@ -0,0 +1,304 @@
+#include "AsyncHttp.h"
+
+#include <AsyncTCP.h>
+#include <HTTPClient.h>
+
+static const size_t MAX_LENGTH_RESPONSE_HEADER = 768;
+
+struct AsyncHttpConnection
+{
+    // Created, closed and deleted only by the task that begins the requests, the AsyncTCP callbacks just set flags
+    AsyncClient *client;
+    IPAddress ip;
+    uint16_t port;
+    volatile bool connected;
+    // Set under the lock by the last callback of the client, it is deleted on the next service after that
+    volatile bool disconnected;
+    // The response asked for the connection to be closed
+    volatile bool closeRequested;
+
+    // Request in flight, pending is only changed while holding the lock.
+    // Written by serviceAsyncHttp() only, so all writes happen on the task that began the request.
+    volatile bool pending;
+    String requestHeader;
+    size_t headerSent;
+    const char *body;
+    size_t bodyLength;
+    size_t bodySent;
+    unsigned long startedAt;
+    AsyncHttpTimeouts timeouts;
+    AsyncHttpCallback callback;
+    void *arg;
+
+    // Response, only the status and the length of the body are of interest
+    char header[MAX_LENGTH_RESPONSE_HEADER];
+    size_t headerLength;
+    bool headerComplete;
+    int status;
+    long bodyRemaining;
+    bool keepAlive;
+};
+
+static AsyncHttpConnection connections[MAX_ASYNC_HTTP_CONNECTIONS];
+static portMUX_TYPE connectionsLock = portMUX_INITIALIZER_UNLOCKED;
+
+// Whoever gets here first, the response, the disconnect or a deadline, reports the result
+static void finishRequest(AsyncHttpConnection &connection, int status)
+{
+    portENTER_CRITICAL(&connectionsLock);
+    bool pending = connection.pending;
+    connection.pending = false;
+    AsyncHttpCallback callback = connection.callback;
+    void *arg = connection.arg;
+    portEXIT_CRITICAL(&connectionsLock);
+
+    if (pending && callback != NULL)
+        callback(arg, status);
+}
+
+// Writes as much as fits into the TCP window, the rest follows on the next calls as the server acknowledges it
+static void writeRequest(AsyncHttpConnection &connection)
+{
+    size_t written = 1;
+    while (written > 0 && connection.headerSent < connection.requestHeader.length())
+    {
+        written = connection.client->write(connection.requestHeader.c_str() + connection.headerSent, connection.requestHeader.length() - connection.headerSent);
+        connection.headerSent += written;
+    }
+
+    while (written > 0 && connection.headerSent == connection.requestHeader.length() && connection.bodySent < connection.bodyLength)
+    {
+        written = connection.client->write(connection.body + connection.bodySent, connection.bodyLength - connection.bodySent);
+        connection.bodySent += written;
+    }
+}
+
+static bool containsHeader(const char *header, const char *line)
+{
+    return strcasestr(header, line) != NULL;
+}
+
+// Parses the status line and the headers needed to know where the response ends
+static void parseHeader(AsyncHttpConnection &connection)
+{
+    connection.header[connection.headerLength] = '\0';
+
+    int major;
+    int minor;
+    if (sscanf(connection.header, "HTTP/%d.%d %d", &major, &minor, &connection.status) != 3)
+        connection.status = HTTPC_ERROR_NO_HTTP_SERVER;
+
+    const char *length = strcasestr(connection.header, "\r\nContent-Length:");
+    if (length != NULL)
+        connection.bodyRemaining = atol(length + strlen("\r\nContent-Length:"));
+    else if (connection.status == 204 || connection.status == 304)
+        connection.bodyRemaining = 0;
+    else
+        connection.keepAlive = false;
+
+    if (containsHeader(connection.header, "\r\nConnection: close") || containsHeader(connection.header, "\r\nTransfer-Encoding:"))
+        connection.keepAlive = false;
+}
+
+static void handleData(AsyncHttpConnection &connection, const uint8_t *data, size_t len)
+{
+    size_t index = 0;
+    while (!connection.headerComplete && index < len)
+    {
+        if (connection.headerLength >= MAX_LENGTH_RESPONSE_HEADER - 1)
+        {
+            // Headers this long are not expected, the status line is still in the buffer
+            connection.keepAlive = false;
+            connection.headerComplete = true;
+            parseHeader(connection);
+            break;
+        }
+
+        connection.header[connection.headerLength++] = data[index++];
+        if (connection.headerLength >= 4 && memcmp(connection.header + connection.headerLength - 4, "\r\n\r\n", 4) == 0)
+        {
+            connection.headerComplete = true;
+            parseHeader(connection);
+        }
+    }
+
+    if (!connection.headerComplete)
+        return;
+
+    // Closing here would delete the client while AsyncTCP is still in its receive handler, so that is left to the owner
+    connection.bodyRemaining -= len - index;
+    if (!connection.keepAlive)
+    {
+        connection.closeRequested = true;
+        finishRequest(connection, connection.status);
+    }
+    else if (connection.bodyRemaining <= 0)
+    {
+        finishRequest(connection, connection.status);
+    }
+}
+
+static void setupClient(AsyncHttpConnection &connection)
+{
+    AsyncClient *client = new AsyncClient();
+    connection.client = client;
+    connection.connected = false;
+    connection.disconnected = false;
+    connection.closeRequested = false;
+
+    client->onConnect([](void *arg, AsyncClient *client) {
+        AsyncHttpConnection &connection = *(AsyncHttpConnection *)arg;
+        connection.connected = true;
+    }, &connection);
+
+    client->onData([](void *arg, AsyncClient *client, void *data, size_t len) {
+        AsyncHttpConnection &connection = *(AsyncHttpConnection *)arg;
+        if (connection.pending)
+            handleData(connection, (const uint8_t *)data, len);
+    }, &connection);
+
+    // Also called after errors and when the connection is closed from this side, no callback follows it
+    client->onDisconnect([](void *arg, AsyncClient *client) {
+        AsyncHttpConnection &connection = *(AsyncHttpConnection *)arg;
+        portENTER_CRITICAL(&connectionsLock);
+        bool wasConnected = connection.connected;
+        connection.connected = false;
+        connection.disconnected = true;
+        portEXIT_CRITICAL(&connectionsLock);
+        finishRequest(connection, wasConnected ? HTTPC_ERROR_CONNECTION_LOST : HTTPC_ERROR_CONNECTION_REFUSED);
+    }, &connection);
+}
+
+// Frees the slot once AsyncTCP is done with the client
+static void reapClient(AsyncHttpConnection &connection)
+{
+    portENTER_CRITICAL(&connectionsLock);
+    AsyncClient *client = connection.disconnected ? connection.client : NULL;
+    if (client != NULL)
+    {
+        connection.client = NULL;
+        connection.disconnected = false;
+    }
+    portEXIT_CRITICAL(&connectionsLock);
+
+    delete client;
+}
+
+// AsyncTCP reports the disconnect from within close(), so the slot is usually free right after
+static void closeClient(AsyncHttpConnection &connection)
+{
+    connection.closeRequested = false;
+    if (connection.client != NULL)
+        connection.client->close(true);
+    reapClient(connection);
+}
+
+static AsyncHttpConnection *findConnection(const IPAddress &ip, uint16_t port)
+{
+    AsyncHttpConnection *unused = NULL;
+    for (unsigned int i = 0; i < MAX_ASYNC_HTTP_CONNECTIONS; i++)
+    {
+        if (connections[i].client != NULL && connections[i].ip == ip && connections[i].port == port)
+            return &connections[i];
+        if (unused == NULL && connections[i].client == NULL)
+            unused = &connections[i];
+    }
+    if (unused != NULL)
+        return unused;
+
+    // More servers than connections, giving up an idle one
+    for (unsigned int i = 0; i < MAX_ASYNC_HTTP_CONNECTIONS; i++)
+    {
+        if (!connections[i].pending)
+        {
+            closeClient(connections[i]);
+            if (connections[i].client == NULL)
+                return &connections[i];
+        }
+    }
+
+    return NULL;
+}
+
+bool beginAsyncRequest(const char *method, const IPAddress &ip, uint16_t port, const String &host, const String &uri,
+                       const char *contentType, const char *body, size_t length, const AsyncHttpTimeouts &timeouts,
+                       AsyncHttpCallback callback, void *arg)
+{
+    for (unsigned int i = 0; i < MAX_ASYNC_HTTP_CONNECTIONS; i++)
+        reapClient(connections[i]);
+
+    AsyncHttpConnection *found = findConnection(ip, port);
+    if (found == NULL || found->pending)
+        return false;
+
+    AsyncHttpConnection &connection = *found;
+    connection.ip = ip;
+    connection.port = port;
+    connection.requestHeader = String(method) + String(" ") + uri + String(" HTTP/1.1\r\nHost: ") + host +
+                        String("\r\nContent-Type: ") + String(contentType) + String("\r\nContent-Length: ") + String(length) +
+                        String("\r\nConnection: keep-alive\r\n\r\n");
+    connection.headerSent = 0;
+    connection.body = body;
+    connection.bodyLength = length;
+    connection.bodySent = 0;
+    connection.headerLength = 0;
+    connection.headerComplete = false;
+    connection.status = 0;
+    connection.bodyRemaining = 0;
+    connection.keepAlive = true;
+    connection.startedAt = millis();
+    connection.timeouts = timeouts;
+    connection.callback = callback;
+    connection.arg = arg;
+
+    portENTER_CRITICAL(&connectionsLock);
+    connection.pending = true;
+    portEXIT_CRITICAL(&connectionsLock);
+
+    if (connection.client == NULL)
+    {
+        setupClient(connection);
+        if (!connection.client->connect(ip, port))
+        {
+            // Nothing was started, so the callback is not called. No disconnect follows a failed connect either,
+            // the client is deleted right away and the slot is free again.
+            portENTER_CRITICAL(&connectionsLock);
+            connection.pending = false;
+            AsyncClient *client = connection.client;
+            connection.client = NULL;
+            portEXIT_CRITICAL(&connectionsLock);
+            delete client;
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void serviceAsyncHttp()
+{
+    unsigned long now = millis();
+    for (unsigned int i = 0; i < MAX_ASYNC_HTTP_CONNECTIONS; i++)
+    {
+        AsyncHttpConnection &connection = connections[i];
+        if (connection.closeRequested)
+            closeClient(connection);
+        reapClient(connection);
+        if (!connection.pending)
+            continue;
+
+        if (connection.connected && connection.client != NULL)
+            writeRequest(connection);
+
+        unsigned long elapsed = now - connection.startedAt;
+        if (!connection.connected && elapsed >= connection.timeouts.connectMs)
+            finishRequest(connection, HTTPC_ERROR_CONNECTION_REFUSED);
+        else if (elapsed >= connection.timeouts.totalMs)
+            finishRequest(connection, HTTPC_ERROR_READ_TIMEOUT);
+        else
+            continue;
+
+        // The connection is in an unknown state after a deadline, so it is not reused
+        closeClient(connection);
+    }
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <Arduino.h>
+#include <IPAddress.h>
+
+const unsigned int MAX_ASYNC_HTTP_CONNECTIONS = 4;
+
+// Called exactly once per request with the status code of the response or a negative HTTPC_ERROR_* code of HTTPClient.
+// It runs on the AsyncTCP task, or on the caller of serviceAsyncHttp() when a deadline passed, so it has to be short.
+typedef void (*AsyncHttpCallback)(void *arg, int status);
+
+struct AsyncHttpTimeouts
+{
+    uint32_t connectMs;
+    uint32_t totalMs;
+};
+
+// Sends a request on AsyncTCP without waiting for the response. Connections are kept alive per address and port,
+// each of them carries one request at a time. The body is not copied and has to stay valid until the callback.
+// Returns false without calling the callback if the request could not be started, e.g. because the connection
+// to this server is still busy.
+bool beginAsyncRequest(const char *method, const IPAddress &ip, uint16_t port, const String &host, const String &uri,
+                       const char *contentType, const char *body, size_t length, const AsyncHttpTimeouts &timeouts,
+                       AsyncHttpCallback callback, void *arg);
+
+// Writes the requests as far as the TCP window allows and fails requests whose connect or total deadline
+// has passed. Has to be called regularly from the task that began the requests while they are pending.
+void serviceAsyncHttp();
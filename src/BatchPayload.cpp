@@ -0,0 +1,138 @@
+#include "BatchPayload.h"
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+// Reserved for the closing bracket of the JSON array and the terminating zero
+static const size_t RESERVED_BATCH_END = 2;
+
+static bool append(BatchWriter &writer, const char *format, ...)
+{
+    if (writer.size < RESERVED_BATCH_END + writer.length)
+        return false;
+    size_t available = writer.size - RESERVED_BATCH_END - writer.length;
+
+    va_list args;
+    va_start(args, format);
+    int written = vsnprintf(writer.buffer + writer.length, available, format, args);
+    va_end(args);
+
+    if (written < 0 || (size_t)written >= available)
+        return false;
+
+    writer.length += written;
+    return true;
+}
+
+// Tag values of the line protocol escape commas, equal signs and spaces, JSON strings quotes and backslashes
+static bool appendEscaped(BatchWriter &writer, const char *value)
+{
+    const char *special = writer.format == BATCH_FORMAT_INFLUX ? ", =" : "\"\\";
+    for (const char *c = value; *c != '\0'; c++)
+    {
+        // Control characters are not expected in names, they are dropped from JSON to keep it valid
+        if (writer.format == BATCH_FORMAT_JSON && (unsigned char)*c < 0x20)
+            continue;
+
+        bool ok = strchr(special, *c) != NULL ? append(writer, "\\%c", *c) : append(writer, "%c", *c);
+        if (!ok)
+            return false;
+    }
+
+    return true;
+}
+
+static bool beginEntry(BatchWriter &writer, const char *measurement, const char *probe)
+{
+    if (writer.format == BATCH_FORMAT_INFLUX)
+    {
+        if (!append(writer, "%s,sensor=", measurement) || !appendEscaped(writer, writer.sensor))
+            return false;
+        if (probe != NULL && (!append(writer, ",probe=") || !appendEscaped(writer, probe)))
+            return false;
+        return append(writer, " ");
+    }
+
+    if (!append(writer, "%s{\"sensor\":\"", writer.entries > 0 ? "," : "") || !appendEscaped(writer, writer.sensor))
+        return false;
+    if (probe != NULL && (!append(writer, "\",\"probe\":\"") || !appendEscaped(writer, probe)))
+        return false;
+    return append(writer, "\"");
+}
+
+static bool endEntry(BatchWriter &writer, time_t time)
+{
+    bool ok;
+    if (writer.format == BATCH_FORMAT_INFLUX)
+        ok = time >= MIN_VALID_BATCH_TIME ? append(writer, " %lld000000000\n", (long long)time) : append(writer, "\n");
+    else
+        ok = time >= MIN_VALID_BATCH_TIME ? append(writer, ",\"time\":%lld}", (long long)time) : append(writer, "}");
+
+    if (ok)
+        writer.entries++;
+    return ok;
+}
+
+void beginBatch(BatchWriter &writer, BatchFormat format, char *buffer, size_t size, const char *sensor)
+{
+    writer.format = format;
+    writer.buffer = buffer;
+    writer.size = size;
+    writer.length = 0;
+    writer.entries = 0;
+    writer.sensor = sensor;
+
+    if (format == BATCH_FORMAT_JSON)
+        append(writer, "[");
+}
+
+bool addBatchSample(BatchWriter &writer, const char *probe, time_t time, float temp, float batteryStatus)
+{
+    size_t start = writer.length;
+    bool ok = beginEntry(writer, "thermometer", probe);
+
+    const char *separator = writer.format == BATCH_FORMAT_INFLUX ? "" : ",\"";
+    const char *assign = writer.format == BATCH_FORMAT_INFLUX ? "=" : "\":";
+    ok = ok && append(writer, "%stemp%s%.2f", separator, assign, temp);
+    if (batteryStatus >= 0.0F)
+        ok = ok && append(writer, writer.format == BATCH_FORMAT_INFLUX ? ",battery=%.3f" : ",\"battery\":%.3f", batteryStatus);
+    ok = ok && endEntry(writer, time);
+
+    if (!ok)
+        writer.length = start;
+    return ok;
+}
+
+bool addBatchStatus(BatchWriter &writer, time_t time, int32_t rssi, uint32_t awakeMs)
+{
+    size_t start = writer.length;
+    bool ok = beginEntry(writer, "thermometer_status", NULL);
+
+    if (writer.format == BATCH_FORMAT_INFLUX)
+        ok = ok && append(writer, "rssi=%ldi,awake_ms=%lui", (long)rssi, (unsigned long)awakeMs);
+    else
+        ok = ok && append(writer, ",\"rssi\":%ld,\"awakeMs\":%lu", (long)rssi, (unsigned long)awakeMs);
+    ok = ok && endEntry(writer, time);
+
+    if (!ok)
+        writer.length = start;
+    return ok;
+}
+
+size_t finishBatch(BatchWriter &writer)
+{
+    if (writer.size < RESERVED_BATCH_END || writer.length > writer.size - RESERVED_BATCH_END)
+        return 0;
+
+    if (writer.format == BATCH_FORMAT_JSON)
+        writer.buffer[writer.length++] = ']';
+    writer.buffer[writer.length] = '\0';
+
+    return writer.length;
+}
+
+const char *batchContentType(BatchFormat format)
+{
+    return format == BATCH_FORMAT_INFLUX ? "text/plain; charset=utf-8" : "application/json";
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <time.h>
+
+// Payloads of batched uploads, kept free of Arduino and ESP-IDF so it can be compiled and run on a host.
+// Everything is written straight into a buffer owned by the caller, nothing is allocated.
+
+enum BatchFormat
+{
+    BATCH_FORMAT_INFLUX,
+    BATCH_FORMAT_JSON
+};
+
+// Times before this are from a clock that was never set, they are left out so the server uses its own
+const time_t MIN_VALID_BATCH_TIME = 1577836800;
+
+struct BatchWriter
+{
+    BatchFormat format;
+    char *buffer;
+    size_t size;
+    size_t length;
+    unsigned int entries;
+    const char *sensor;
+};
+
+void beginBatch(BatchWriter &writer, BatchFormat format, char *buffer, size_t size, const char *sensor);
+
+// probe is NULL for the main thermometer, a negative battery status is left out.
+// Returns false and leaves the batch as it was if the entry does not fit anymore.
+bool addBatchSample(BatchWriter &writer, const char *probe, time_t time, float temp, float batteryStatus);
+
+bool addBatchStatus(BatchWriter &writer, time_t time, int32_t rssi, uint32_t awakeMs);
+
+// Returns the length of the payload, which is zero terminated, or 0 if not even the closing part fits
+size_t finishBatch(BatchWriter &writer);
+
+const char *batchContentType(BatchFormat format);
@@ -0,0 +1,39 @@
+#include "BatteryLevel.h"
+
+uint32_t trimmedMean(uint16_t *samples, size_t count)
+{
+    if (count == 0)
+        return 0;
+
+    // Insertion sort, there are only a few dozen samples
+    for (size_t i = 1; i < count; i++)
+    {
+        uint16_t sample = samples[i];
+        size_t j = i;
+        for (; j > 0 && samples[j - 1] > sample; j--)
+            samples[j] = samples[j - 1];
+        samples[j] = sample;
+    }
+
+    size_t first = count / 4;
+    size_t last = count - count / 4;
+    uint32_t sum = 0;
+    for (size_t i = first; i < last; i++)
+        sum += samples[i];
+
+    return (sum + (last - first) / 2) / (last - first);
+}
+
+uint32_t sampleBatteryMillivolts(Hal &hal, uint32_t &raw, size_t &sampleCount)
+{
+    uint16_t samples[MAX_SAMPLES_BATTERY];
+    sampleCount = 0;
+    uint32_t start = hal.micros();
+    while (sampleCount < MAX_SAMPLES_BATTERY && (sampleCount == 0 || hal.micros() - start < BUDGET_US_BATTERY))
+    {
+        samples[sampleCount++] = hal.analogReadBattery();
+    }
+
+    raw = trimmedMean(samples, sampleCount);
+    return hal.batteryMillivoltsFrom(raw);
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "Hal.h"
+
+// Battery level of a single Li-ion cell, kept free of Arduino and ESP-IDF so it can be compiled and run on a host.
+
+const size_t MAX_SAMPLES_BATTERY = 64;
+const uint32_t BUDGET_US_BATTERY = 10000;
+
+struct BatteryCurvePoint
+{
+    uint16_t millivolts;
+    float level;
+};
+
+// Resting voltage of a typical Li-ion cell over its charge, the level is interpolated linearly in between
+constexpr BatteryCurvePoint LI_ION_CURVE[] = {
+    {3000, 0.00F}, {3300, 0.05F}, {3600, 0.10F}, {3700, 0.20F}, {3750, 0.30F}, {3790, 0.40F},
+    {3830, 0.50F}, {3870, 0.60F}, {3920, 0.70F}, {3980, 0.80F}, {4080, 0.90F}, {4200, 1.00F}};
+
+constexpr size_t LI_ION_CURVE_POINTS = sizeof(LI_ION_CURVE) / sizeof(LI_ION_CURVE[0]);
+
+constexpr bool isCurveAscending(size_t index = 1)
+{
+    return index >= LI_ION_CURVE_POINTS ||
+           (LI_ION_CURVE[index].millivolts > LI_ION_CURVE[index - 1].millivolts &&
+            LI_ION_CURVE[index].level >= LI_ION_CURVE[index - 1].level && isCurveAscending(index + 1));
+}
+
+static_assert(isCurveAscending(), "LI_ION_CURVE has to be sorted by voltage and level");
+
+constexpr float interpolateCurve(uint32_t millivolts, size_t index)
+{
+    return (LI_ION_CURVE[index - 1].level +
+            (LI_ION_CURVE[index].level - LI_ION_CURVE[index - 1].level) * (float)(millivolts - LI_ION_CURVE[index - 1].millivolts) /
+                (float)(LI_ION_CURVE[index].millivolts - LI_ION_CURVE[index - 1].millivolts));
+}
+
+constexpr float batteryLevelFrom(uint32_t millivolts, size_t index = 1)
+{
+    return millivolts <= LI_ION_CURVE[0].millivolts ? LI_ION_CURVE[0].level
+         : index >= LI_ION_CURVE_POINTS ? LI_ION_CURVE[LI_ION_CURVE_POINTS - 1].level
+         : millivolts <= LI_ION_CURVE[index].millivolts ? interpolateCurve(millivolts, index)
+         : batteryLevelFrom(millivolts, index + 1);
+}
+
+// Sorts the samples and averages the middle half, so single spikes of the ADC do not move the result.
+// Returns 0 without samples.
+uint32_t trimmedMean(uint16_t *samples, size_t count);
+
+// Takes as many samples as fit into the time budget and drops the outliers before calibrating
+uint32_t sampleBatteryMillivolts(Hal &hal, uint32_t &raw, size_t &sampleCount);
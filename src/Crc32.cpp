@@ -0,0 +1,23 @@
+#include "Crc32.h"
+
+#ifdef ARDUINO
+#include <rom/crc.h>
+#else
+static uint32_t crc32_le(uint32_t crc, const uint8_t *data, size_t length)
+{
+    crc = ~crc;
+    for (size_t i = 0; i < length; i++)
+    {
+        crc ^= data[i];
+        for (uint8_t bit = 0; bit < 8; bit++)
+            crc = crc & 1 ? (crc >> 1) ^ 0xEDB88320 : crc >> 1;
+    }
+
+    return ~crc;
+}
+#endif
+
+uint32_t computeCrc32(const void *data, size_t length)
+{
+    return crc32_le(0, (const uint8_t *)data, length);
+}
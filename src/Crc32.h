@@ -0,0 +1,8 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// CRC-32 of zlib, the same as crc32_le() of the ESP32 ROM. The ROM function is used on the device,
+// hosts compute it in software.
+uint32_t computeCrc32(const void *data, size_t length);
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <time.h>
+
+// Hardware and clocks the firmware depends on, implemented with the Arduino libraries in main.cpp and by simulations
+// on a host. Probes are addressed by their index in the probe table, the first one is the main thermometer.
+class Hal
+{
+public:
+    virtual ~Hal() {}
+
+    // Monotonic clocks since the start, like millis() and micros()
+    virtual uint32_t millis() = 0;
+    virtual uint32_t micros() = 0;
+    virtual void delay(uint32_t ms) = 0;
+    // Wall clock in seconds since 1970, before it was set it counts from 0
+    virtual time_t time() = 0;
+    virtual uint32_t random() = 0;
+
+    // OneWire bus with DS18B20 probes, one conversion is started for all of them
+    virtual unsigned int probeCount() = 0;
+    virtual uint8_t getResolution() = 0;
+    virtual void setResolution(uint8_t resolution) = 0;
+    virtual uint32_t millisToWaitForConversion(uint8_t resolution) = 0;
+    virtual void requestTemperatures() = 0;
+    virtual bool isConversionComplete() = 0;
+    // -127 like DallasTemperature if the probe did not answer
+    virtual float getTempC(unsigned int probe) = 0;
+    // ROM addresses of all devices on the bus, whatever their family and without checking their CRC
+    virtual void resetBusSearch() = 0;
+    virtual bool searchBus(uint8_t *rom) = 0;
+
+    // One raw sample of the battery voltage divider and its calibrated voltage at the battery
+    virtual uint16_t analogReadBattery() = 0;
+    virtual uint32_t batteryMillivoltsFrom(uint32_t raw) = 0;
+
+    // Preferences like the Arduino class, a namespace is opened, used and closed again. The getters return the
+    // fallback if the key does not exist, getBytes() returns 0 then. Strings are truncated to the buffer.
+    virtual bool beginPreferences(const char *space, bool readOnly) = 0;
+    virtual void endPreferences() = 0;
+    virtual bool isKey(const char *key) = 0;
+    virtual bool getBool(const char *key, bool fallback) = 0;
+    virtual uint32_t getUInt(const char *key, uint32_t fallback) = 0;
+    virtual float getFloat(const char *key, float fallback) = 0;
+    virtual void getString(const char *key, const char *fallback, char *buffer, size_t length) = 0;
+    virtual size_t getBytes(const char *key, void *buffer, size_t length) = 0;
+    virtual size_t putUInt(const char *key, uint32_t value) = 0;
+    virtual size_t putString(const char *key, const char *value) = 0;
+    virtual size_t putBytes(const char *key, const void *data, size_t length) = 0;
+    virtual bool removeKey(const char *key) = 0;
+    virtual bool clearPreferences() = 0;
+
+    // Files on the flash file system, used by the reading log. mountFiles() formats it if it cannot be mounted
+    // and listFiles() calls back with the name and size of every file in the directory.
+    typedef void (*FileVisitor)(const char *name, size_t size, void *context);
+    virtual bool mountFiles() = 0;
+    virtual bool makeDirectory(const char *path) = 0;
+    virtual bool listFiles(const char *directory, FileVisitor visit, void *context) = 0;
+    virtual size_t appendFile(const char *path, const void *data, size_t length) = 0;
+    virtual size_t readFile(const char *path, size_t offset, void *buffer, size_t length) = 0;
+    virtual bool removeFile(const char *path) = 0;
+
+    // Status code of the response or a negative HTTPC_ERROR_* code of HTTPClient
+    virtual int sendRequest(const char *method, const char *address, const char *contentType, const char *body, size_t length) = 0;
+
+    // Does not return on the device, simulations record the wake up time and return
+    virtual void deepSleep(uint64_t micros) = 0;
+};
@@ -0,0 +1,68 @@
+#include "PhaseTimings.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+static const char *PHASE_NAMES[PHASE_COUNT] = {
+    "hall",
+    "settings",
+    "wifi",
+    "sensors",
+    "temperature",
+    "battery",
+    "putTemperature",
+    "putBattery",
+    "awake",
+};
+
+static int compareDurations(const void *a, const void *b)
+{
+    return (int)*(const uint16_t *)a - (int)*(const uint16_t *)b;
+}
+
+const char *phaseName(Phase phase)
+{
+    return phase < PHASE_COUNT ? PHASE_NAMES[phase] : "unknown";
+}
+
+void recordPhase(PhaseTimings &timings, Phase phase, uint32_t durationMs)
+{
+    uint16_t duration = durationMs > UINT16_MAX ? UINT16_MAX : (uint16_t)durationMs;
+
+    timings.durations[phase][timings.next[phase]] = duration;
+    timings.next[phase] = (timings.next[phase] + 1) % PHASE_TIMINGS_WINDOW;
+    if (timings.count[phase] < PHASE_TIMINGS_WINDOW)
+        timings.count[phase]++;
+    timings.last[phase] = duration;
+}
+
+PhaseSummary summarizePhase(const PhaseTimings &timings, Phase phase)
+{
+    PhaseSummary summary;
+    memset(&summary, 0, sizeof(summary));
+
+    summary.count = timings.count[phase];
+    if (summary.count == 0)
+        return summary;
+
+    uint16_t sorted[PHASE_TIMINGS_WINDOW];
+    memcpy(sorted, timings.durations[phase], summary.count * sizeof(uint16_t));
+    qsort(sorted, summary.count, sizeof(uint16_t), compareDurations);
+
+    uint32_t sum = 0;
+    for (uint8_t i = 0; i < summary.count; i++)
+    {
+        sum += sorted[i];
+    }
+
+    // Nearest rank, so with few samples p95 is the maximum
+    uint8_t rank = (summary.count * 95 + 99) / 100;
+
+    summary.last = timings.last[phase];
+    summary.min = sorted[0];
+    summary.avg = sum / summary.count;
+    summary.max = sorted[summary.count - 1];
+    summary.p95 = sorted[rank - 1];
+
+    return summary;
+}
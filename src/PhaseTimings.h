@@ -0,0 +1,45 @@
+#pragma once
+
+#include <stdint.h>
+
+const uint8_t PHASE_TIMINGS_WINDOW = 32;
+
+enum Phase
+{
+    PHASE_HALL,
+    PHASE_SETTINGS,
+    PHASE_WIFI,
+    PHASE_SENSORS,
+    PHASE_TEMPERATURE,
+    PHASE_BATTERY,
+    PHASE_PUT_TEMPERATURE,
+    PHASE_PUT_BATTERY,
+    PHASE_AWAKE,
+    PHASE_COUNT
+};
+
+// The last PHASE_TIMINGS_WINDOW durations of every phase in milliseconds.
+// Plain data only, so it can be kept in RTC memory across deep sleep.
+struct PhaseTimings
+{
+    uint16_t durations[PHASE_COUNT][PHASE_TIMINGS_WINDOW];
+    uint8_t next[PHASE_COUNT];
+    uint8_t count[PHASE_COUNT];
+    uint16_t last[PHASE_COUNT];
+};
+
+struct PhaseSummary
+{
+    uint8_t count;
+    uint16_t last;
+    uint16_t min;
+    uint16_t avg;
+    uint16_t max;
+    uint16_t p95;
+};
+
+const char *phaseName(Phase phase);
+
+void recordPhase(PhaseTimings &timings, Phase phase, uint32_t durationMs);
+
+PhaseSummary summarizePhase(const PhaseTimings &timings, Phase phase);
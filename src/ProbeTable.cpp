@@ -0,0 +1,139 @@
+#include "ProbeTable.h"
+
+#include <stdio.h>
+#include <string.h>
+
+static const uint8_t TEMPERATURE_FAMILIES[] = {0x10, 0x22, 0x28, 0x3B, 0x42};
+static const float TEMP_UNKNOWN = -127.0F;
+static const size_t LENGTH_PROBE_KEY = 16;
+
+uint8_t computeCrc8(const uint8_t *data, size_t length)
+{
+    uint8_t crc = 0;
+    for (size_t i = 0; i < length; i++)
+    {
+        crc ^= data[i];
+        for (uint8_t bit = 0; bit < 8; bit++)
+            crc = crc & 1 ? (crc >> 1) ^ 0x8C : crc >> 1;
+    }
+
+    return crc;
+}
+
+void formatRom(const uint8_t *rom, char *buffer)
+{
+    for (size_t i = 0; i < LENGTH_PROBE_ROM; i++)
+        snprintf(buffer + 2 * i, 3, "%02x", rom[i]);
+}
+
+bool isTemperatureProbe(const uint8_t *rom)
+{
+    if (computeCrc8(rom, LENGTH_PROBE_ROM - 1) != rom[LENGTH_PROBE_ROM - 1])
+        return false;
+
+    for (uint8_t family : TEMPERATURE_FAMILIES)
+    {
+        if (rom[0] == family)
+            return true;
+    }
+
+    return false;
+}
+
+int findProbe(const Probe *probes, unsigned int count, const uint8_t *rom)
+{
+    for (unsigned int i = 0; i < count; i++)
+    {
+        if (memcmp(probes[i].rom, rom, LENGTH_PROBE_ROM) == 0)
+            return i;
+    }
+
+    return -1;
+}
+
+unsigned int enumerateProbes(Hal &hal, Probe *probes, unsigned int &count, bool *present)
+{
+    for (unsigned int i = 0; i < MAX_PROBES; i++)
+        present[i] = false;
+
+    unsigned int added = 0;
+    uint8_t rom[LENGTH_PROBE_ROM];
+    hal.resetBusSearch();
+    while (hal.searchBus(rom))
+    {
+        if (!isTemperatureProbe(rom))
+            continue;
+
+        int known = findProbe(probes, count, rom);
+        if (known >= 0)
+        {
+            present[known] = true;
+            continue;
+        }
+
+        if (count >= MAX_PROBES)
+            continue;
+
+        Probe &probe = probes[count];
+        memcpy(probe.rom, rom, LENGTH_PROBE_ROM);
+        formatRom(rom, probe.name);
+        probe.reportAddress[0] = '\0';
+        probe.temp = TEMP_UNKNOWN;
+        present[count++] = true;
+        added++;
+    }
+
+    return added;
+}
+
+static void probeKey(const char *id, unsigned int index, char *key)
+{
+    snprintf(key, LENGTH_PROBE_KEY, "%s%u", id, index);
+}
+
+void readStoredProbes(Hal &hal, Probe *probes, unsigned int &count)
+{
+    hal.beginPreferences(PREFS_NAME_PROBES, true);
+
+    count = hal.getUInt(ID_PROBE_COUNT, 0);
+    if (count > MAX_PROBES)
+        count = MAX_PROBES;
+
+    char key[LENGTH_PROBE_KEY];
+    for (unsigned int i = 0; i < count; i++)
+    {
+        probeKey(ID_PROBE_ROM, i, key);
+        if (hal.getBytes(key, probes[i].rom, LENGTH_PROBE_ROM) != LENGTH_PROBE_ROM)
+            memset(probes[i].rom, 0, LENGTH_PROBE_ROM);
+
+        char romString[LENGTH_ROM_STRING];
+        formatRom(probes[i].rom, romString);
+        probeKey(ID_PROBE_NAME, i, key);
+        hal.getString(key, romString, probes[i].name, sizeof(probes[i].name));
+        probeKey(ID_PROBE_ADDRESS, i, key);
+        hal.getString(key, "", probes[i].reportAddress, sizeof(probes[i].reportAddress));
+        probes[i].temp = TEMP_UNKNOWN;
+    }
+
+    hal.endPreferences();
+}
+
+void writeStoredProbes(Hal &hal, const Probe *probes, unsigned int count)
+{
+    hal.beginPreferences(PREFS_NAME_PROBES, false);
+
+    hal.clearPreferences();
+    hal.putUInt(ID_PROBE_COUNT, count);
+    char key[LENGTH_PROBE_KEY];
+    for (unsigned int i = 0; i < count; i++)
+    {
+        probeKey(ID_PROBE_ROM, i, key);
+        hal.putBytes(key, probes[i].rom, LENGTH_PROBE_ROM);
+        probeKey(ID_PROBE_NAME, i, key);
+        hal.putString(key, probes[i].name);
+        probeKey(ID_PROBE_ADDRESS, i, key);
+        hal.putString(key, probes[i].reportAddress);
+    }
+
+    hal.endPreferences();
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "Hal.h"
+#include "SettingsRecord.h"
+
+// The DS18B20 probes on the OneWire bus with their names and report addresses, kept free of Arduino and ESP-IDF so it
+// can be compiled and run on a host. The table is stored in its own namespace of Preferences with one key per field.
+
+const unsigned int MAX_PROBES = 8;
+const size_t LENGTH_PROBE_ROM = 8;
+const size_t LENGTH_ROM_STRING = 2 * LENGTH_PROBE_ROM + 1;
+
+const char PREFS_NAME_PROBES[] = "probes";
+const char ID_PROBE_COUNT[] = "count";
+const char ID_PROBE_ROM[] = "rom";
+const char ID_PROBE_NAME[] = "name";
+const char ID_PROBE_ADDRESS[] = "address";
+
+// Fixed size fields, so the web server can read them while the owning task changes them
+struct Probe
+{
+    uint8_t rom[LENGTH_PROBE_ROM];
+    char name[LENGTH_SETTING_NAME];
+    char reportAddress[LENGTH_SETTING_ADDRESS];
+    float temp;
+};
+
+// CRC-8 of the OneWire ROM addresses and scratchpads, the last byte of a ROM is the CRC of the others
+uint8_t computeCrc8(const uint8_t *data, size_t length);
+
+// Hex digits in the order of the bus, the default name of a new probe
+void formatRom(const uint8_t *rom, char *buffer);
+
+// A valid ROM of one of the families DallasTemperature reads: DS18S20, DS1822, DS18B20, DS1825 and DS28EA00
+bool isTemperatureProbe(const uint8_t *rom);
+
+// Index of the probe with this ROM or -1
+int findProbe(const Probe *probes, unsigned int count, const uint8_t *rom);
+
+// Searches the bus and appends new probes, so adding one never changes which probe is the main thermometer.
+// Known probes keep their slot even if they are missing, present tells which ones answered.
+// Returns the number of probes that were added.
+unsigned int enumerateProbes(Hal &hal, Probe *probes, unsigned int &count, bool *present);
+
+void readStoredProbes(Hal &hal, Probe *probes, unsigned int &count);
+
+void writeStoredProbes(Hal &hal, const Probe *probes, unsigned int count);
@@ -0,0 +1,119 @@
+#include "ReadingDatagram.h"
+
+#include <math.h>
+#include <string.h>
+
+static const uint8_t MAGIC_READING_DATAGRAM[2] = {'T', 'H'};
+
+static int16_t toFixedPoint(float value, float scale)
+{
+    long fixed = lroundf(value * scale);
+    // The lowest value marks missing temperatures
+    return (int16_t)(fixed < -32767L ? -32767L : (fixed > 32767L ? 32767L : fixed));
+}
+
+static uint16_t crc16(const uint8_t *data, size_t length)
+{
+    uint16_t crc = 0xFFFF;
+    for (size_t i = 0; i < length; i++)
+    {
+        crc ^= (uint16_t)data[i] << 8;
+        for (uint8_t bit = 0; bit < 8; bit++)
+            crc = crc & 0x8000 ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+    }
+
+    return crc;
+}
+
+static void writeUInt16(uint8_t *out, uint16_t value)
+{
+    out[0] = (uint8_t)value;
+    out[1] = (uint8_t)(value >> 8);
+}
+
+static size_t datagramLength(size_t nameLength, uint8_t probeCount)
+{
+    return LENGTH_DATAGRAM_HEADER + nameLength + 1 + probeCount * 2 + 2;
+}
+
+static uint16_t readUInt16(const uint8_t *in)
+{
+    return (uint16_t)(in[0] | in[1] << 8);
+}
+
+size_t encodeReadingDatagram(const ReadingDatagram &datagram, uint8_t *buffer, size_t size)
+{
+    size_t nameLength = strnlen(datagram.name, MAX_DATAGRAM_NAME);
+    uint8_t probeCount = datagram.probeCount < MAX_DATAGRAM_PROBES ? datagram.probeCount : MAX_DATAGRAM_PROBES;
+    size_t length = datagramLength(nameLength, probeCount);
+    if (length > size)
+        return 0;
+
+    uint32_t time = datagram.time > 0 ? (uint32_t)datagram.time : 0;
+    uint8_t flags = (datagram.tempValid ? DATAGRAM_FLAG_TEMP : 0) | (datagram.batteryValid ? DATAGRAM_FLAG_BATTERY : 0);
+
+    buffer[0] = MAGIC_READING_DATAGRAM[0];
+    buffer[1] = MAGIC_READING_DATAGRAM[1];
+    buffer[2] = READING_DATAGRAM_VERSION;
+    buffer[3] = flags;
+    writeUInt16(buffer + 4, datagram.sequence);
+    writeUInt16(buffer + 6, (uint16_t)time);
+    writeUInt16(buffer + 8, (uint16_t)(time >> 16));
+    writeUInt16(buffer + 10, (uint16_t)(datagram.tempValid ? toFixedPoint(datagram.temp, 100.0F) : DATAGRAM_NO_TEMP));
+    writeUInt16(buffer + 12, (uint16_t)(datagram.batteryValid ? toFixedPoint(datagram.batteryStatus, 1000.0F) : 0));
+    buffer[14] = (uint8_t)datagram.rssi;
+    buffer[15] = (uint8_t)nameLength;
+    memcpy(buffer + LENGTH_DATAGRAM_HEADER, datagram.name, nameLength);
+
+    size_t position = LENGTH_DATAGRAM_HEADER + nameLength;
+    buffer[position++] = probeCount;
+    for (uint8_t i = 0; i < probeCount; i++)
+    {
+        int16_t temp = datagram.probeValid[i] ? toFixedPoint(datagram.probeTemps[i], 100.0F) : DATAGRAM_NO_TEMP;
+        writeUInt16(buffer + position, (uint16_t)temp);
+        position += 2;
+    }
+
+    writeUInt16(buffer + position, crc16(buffer, position));
+    return length;
+}
+
+bool decodeReadingDatagram(const uint8_t *data, size_t length, ReadingDatagram &datagram)
+{
+    if (length < datagramLength(0, 0) || data[0] != MAGIC_READING_DATAGRAM[0] || data[1] != MAGIC_READING_DATAGRAM[1] ||
+        data[2] == 0 || data[2] > READING_DATAGRAM_VERSION)
+        return false;
+
+    if (readUInt16(data + length - 2) != crc16(data, length - 2))
+        return false;
+
+    uint8_t nameLength = data[15];
+    if (nameLength > MAX_DATAGRAM_NAME || datagramLength(nameLength, 0) > length)
+        return false;
+
+    uint8_t probeCount = data[LENGTH_DATAGRAM_HEADER + nameLength];
+    if (probeCount > MAX_DATAGRAM_PROBES || datagramLength(nameLength, probeCount) != length)
+        return false;
+
+    int16_t temp = (int16_t)readUInt16(data + 10);
+    datagram.sequence = readUInt16(data + 4);
+    datagram.time = (time_t)((uint32_t)readUInt16(data + 6) | (uint32_t)readUInt16(data + 8) << 16);
+    datagram.tempValid = (data[3] & DATAGRAM_FLAG_TEMP) != 0 && temp != DATAGRAM_NO_TEMP;
+    datagram.temp = temp / 100.0F;
+    datagram.batteryValid = (data[3] & DATAGRAM_FLAG_BATTERY) != 0;
+    datagram.batteryStatus = (int16_t)readUInt16(data + 12) / 1000.0F;
+    datagram.rssi = (int8_t)data[14];
+    memcpy(datagram.name, data + LENGTH_DATAGRAM_HEADER, nameLength);
+    datagram.name[nameLength] = '\0';
+
+    datagram.probeCount = probeCount;
+    const uint8_t *probes = data + LENGTH_DATAGRAM_HEADER + nameLength + 1;
+    for (uint8_t i = 0; i < probeCount; i++)
+    {
+        int16_t probeTemp = (int16_t)readUInt16(probes + i * 2);
+        datagram.probeValid[i] = probeTemp != DATAGRAM_NO_TEMP;
+        datagram.probeTemps[i] = probeTemp / 100.0F;
+    }
+
+    return true;
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <time.h>
+
+// Readings as single UDP datagrams, kept free of Arduino and ESP-IDF so it can be compiled and run on a host.
+// Little endian layout:
+//   0  'T' 'H'                      magic
+//   2  uint8  version
+//   3  uint8  flags                 DATAGRAM_FLAG_*
+//   4  uint16 sequence              counts up per datagram, so collectors can tell lost ones
+//   6  uint32 time                  seconds since 1970, 0 if the clock was not set
+//  10  int16  temperature           centi-degrees
+//  12  int16  battery               per-mille
+//  14  int8   rssi                  dBm
+//  15  uint8  name length n
+//  16  n bytes name                 not terminated
+//      uint8  probe count p
+//      p * int16 probe temperatures centi-degrees, DATAGRAM_NO_TEMP if the probe has no valid reading
+//      uint16 CRC-16/CCITT-FALSE    of everything before
+// A receiver rejects versions newer than the one it knows.
+
+const uint8_t READING_DATAGRAM_VERSION = 1;
+const uint8_t MAX_DATAGRAM_NAME = 32;
+const uint8_t MAX_DATAGRAM_PROBES = 8;
+// Magic up to the name length, the name and the probes follow
+const size_t LENGTH_DATAGRAM_HEADER = 16;
+const size_t MAX_SIZE_READING_DATAGRAM = LENGTH_DATAGRAM_HEADER + MAX_DATAGRAM_NAME + 1 + MAX_DATAGRAM_PROBES * 2 + 2;
+
+const uint8_t DATAGRAM_FLAG_TEMP = 0x01;
+const uint8_t DATAGRAM_FLAG_BATTERY = 0x02;
+const int16_t DATAGRAM_NO_TEMP = -32768;
+
+struct ReadingDatagram
+{
+    uint16_t sequence;
+    time_t time;
+    // Invalid temperatures and negative battery states are left out
+    bool tempValid;
+    float temp;
+    bool batteryValid;
+    float batteryStatus;
+    int8_t rssi;
+    char name[MAX_DATAGRAM_NAME + 1];
+    uint8_t probeCount;
+    bool probeValid[MAX_DATAGRAM_PROBES];
+    float probeTemps[MAX_DATAGRAM_PROBES];
+};
+
+// Returns the length of the datagram or 0 if the buffer is too small. Longer names and more probes are cut off.
+size_t encodeReadingDatagram(const ReadingDatagram &datagram, uint8_t *buffer, size_t size);
+
+bool decodeReadingDatagram(const uint8_t *data, size_t length, ReadingDatagram &datagram);
@@ -0,0 +1,196 @@
+#include "ReadingLog.h"
+#include "Crc32.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static const char LOG_DIRECTORY[] = "/log";
+static const size_t LENGTH_SEGMENT_PATH = 32;
+
+static bool mounted = false;
+static uint32_t firstSequence = 0;
+static uint32_t nextSequence = 0;
+static uint32_t currentSegmentFirst = 0;
+static unsigned int segmentCount = 0;
+
+struct SegmentScan
+{
+    uint32_t sequence;
+    uint32_t oldest;
+    uint32_t containing;
+    size_t containingSize;
+    bool found;
+    unsigned int count;
+};
+
+static void segmentPath(uint32_t first, char *path)
+{
+    snprintf(path, LENGTH_SEGMENT_PATH, "%s/%010lu", LOG_DIRECTORY, (unsigned long)first);
+}
+
+static uint32_t recordCrc(const LogRecord &record)
+{
+    return computeCrc32(&record, offsetof(LogRecord, crc));
+}
+
+static void visitSegment(const char *name, size_t size, void *context)
+{
+    SegmentScan &scan = *(SegmentScan *)context;
+    const char *separator = strrchr(name, '/');
+    uint32_t first = strtoul(separator != NULL ? separator + 1 : name, NULL, 10);
+
+    if (scan.count == 0 || first < scan.oldest)
+        scan.oldest = first;
+    if (first <= scan.sequence && (!scan.found || first > scan.containing))
+    {
+        scan.containing = first;
+        scan.containingSize = size;
+        scan.found = true;
+    }
+    scan.count++;
+}
+
+// Looks for the oldest segment and the newest one that starts at or before the given sequence
+static bool scanSegments(Hal &hal, uint32_t sequence, SegmentScan &scan)
+{
+    memset(&scan, 0, sizeof(scan));
+    scan.sequence = sequence;
+
+    return hal.listFiles(LOG_DIRECTORY, visitSegment, &scan) && scan.count > 0;
+}
+
+// Starts a new segment with the next sequence number and removes the oldest ones beyond the limit
+static void rotateSegments(Hal &hal)
+{
+    currentSegmentFirst = nextSequence;
+    segmentCount++;
+
+    while (segmentCount > MAX_LOG_SEGMENTS)
+    {
+        SegmentScan scan;
+        if (!scanSegments(hal, 0, scan))
+            break;
+
+        char path[LENGTH_SEGMENT_PATH];
+        segmentPath(scan.oldest, path);
+        hal.removeFile(path);
+        // The new segment does not exist yet, so the scan counted one file less than there will be
+        segmentCount = scan.count;
+
+        firstSequence = scanSegments(hal, 0, scan) ? scan.oldest : nextSequence;
+    }
+}
+
+bool beginReadingLog(Hal &hal)
+{
+    mounted = false;
+    firstSequence = 0;
+    nextSequence = 0;
+    currentSegmentFirst = 0;
+    segmentCount = 0;
+
+    if (!hal.mountFiles() || !hal.makeDirectory(LOG_DIRECTORY))
+        return false;
+
+    SegmentScan scan;
+    if (scanSegments(hal, UINT32_MAX, scan))
+    {
+        firstSequence = scan.oldest;
+        currentSegmentFirst = scan.containing;
+        nextSequence = scan.containing + scan.containingSize / sizeof(LogRecord);
+        segmentCount = scan.count;
+
+        // A record cut off by a power loss would shift all following ones, so a new segment is started.
+        // It starts with the next sequence number, so the log stays contiguous.
+        if (scan.containingSize % sizeof(LogRecord) != 0)
+        {
+            // Without a complete record the segment has the name of the new one, so it is replaced
+            if (nextSequence == scan.containing)
+            {
+                char path[LENGTH_SEGMENT_PATH];
+                segmentPath(scan.containing, path);
+                hal.removeFile(path);
+                segmentCount--;
+            }
+
+            rotateSegments(hal);
+        }
+    }
+
+    mounted = true;
+    return true;
+}
+
+bool appendReadingLog(Hal &hal, const Sample &sample)
+{
+    if (!mounted)
+        return false;
+
+    if (segmentCount == 0 || nextSequence - currentSegmentFirst >= RECORDS_PER_LOG_SEGMENT)
+        rotateSegments(hal);
+
+    LogRecord record;
+    record.sequence = nextSequence;
+    record.time = (uint32_t)sample.time;
+    record.temp = sample.temp;
+    record.batteryStatus = sample.batteryStatus;
+    record.crc = recordCrc(record);
+
+    char path[LENGTH_SEGMENT_PATH];
+    segmentPath(currentSegmentFirst, path);
+    bool written = hal.appendFile(path, &record, sizeof(record)) == sizeof(record);
+
+    if (written)
+        nextSequence++;
+
+    return written;
+}
+
+uint32_t firstReadingLogSequence()
+{
+    return firstSequence;
+}
+
+uint32_t nextReadingLogSequence()
+{
+    return nextSequence;
+}
+
+size_t readReadingLog(Hal &hal, uint32_t &sequence, LogRecord *records, size_t maxRecords)
+{
+    if (!mounted)
+        return 0;
+
+    if (sequence < firstSequence)
+        sequence = firstSequence;
+
+    size_t count = 0;
+    while (count < maxRecords && sequence < nextSequence)
+    {
+        SegmentScan scan;
+        if (!scanSegments(hal, sequence, scan) || !scan.found)
+            break;
+
+        // Read straight into the free part of records, then the ones with a wrong CRC are dropped in place
+        char path[LENGTH_SEGMENT_PATH];
+        segmentPath(scan.containing, path);
+        size_t length = hal.readFile(path, (sequence - scan.containing) * sizeof(LogRecord), records + count,
+                                     (maxRecords - count) * sizeof(LogRecord));
+        size_t read = length / sizeof(LogRecord);
+        if (read == 0)
+            break;
+
+        // Segments are contiguous, so the next one is found again by the advanced sequence
+        sequence += read;
+        size_t kept = count;
+        for (size_t i = count; i < count + read; i++)
+        {
+            if (records[i].crc == recordCrc(records[i]))
+                records[kept++] = records[i];
+        }
+        count = kept;
+    }
+
+    return count;
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "Hal.h"
+#include "SampleCodec.h"
+
+// Log of readings on flash, kept free of Arduino and ESP-IDF so it can be compiled and run on a host.
+
+const uint32_t RECORDS_PER_LOG_SEGMENT = 512;
+const unsigned int MAX_LOG_SEGMENTS = 24;
+
+// Fixed size, so the position of a record in its segment follows from its sequence number
+struct LogRecord
+{
+    uint32_t sequence;
+    uint32_t time;
+    float temp;
+    float batteryStatus;
+    uint32_t crc;
+};
+
+// Append-only log of readings on the file system of the HAL, split into segment files named after their first
+// sequence number. When the last segment is full a new one is started and the oldest is deleted once there are too many.
+bool beginReadingLog(Hal &hal);
+
+bool appendReadingLog(Hal &hal, const Sample &sample);
+
+uint32_t firstReadingLogSequence();
+
+uint32_t nextReadingLogSequence();
+
+// Reads up to maxRecords valid records starting at sequence, records with a wrong CRC are skipped.
+// sequence is advanced past everything that was read, 0 records means the end of the log.
+size_t readReadingLog(Hal &hal, uint32_t &sequence, LogRecord *records, size_t maxRecords);
@@ -0,0 +1,32 @@
+#include "ReadingSnapshot.h"
+
+#include <atomic>
+#include <string.h>
+
+// Odd while a reading is being published
+static std::atomic<uint32_t> sequence(0);
+static Reading snapshot;
+
+void publishReading(const Reading &reading)
+{
+    uint32_t current = sequence.load(std::memory_order_relaxed);
+    sequence.store(current + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    memcpy(&snapshot, &reading, sizeof(Reading));
+
+    sequence.store(current + 2, std::memory_order_release);
+}
+
+void readReading(Reading &reading)
+{
+    uint32_t before;
+    uint32_t after;
+    do
+    {
+        before = sequence.load(std::memory_order_acquire);
+        memcpy(&reading, &snapshot, sizeof(Reading));
+        std::atomic_thread_fence(std::memory_order_acquire);
+        after = sequence.load(std::memory_order_relaxed);
+    } while ((before & 1) != 0 || before != after);
+}
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <stdint.h>
+
+const unsigned int MAX_READING_PROBES = 8;
+
+// Latest values of a sampling cycle, copied as a whole so temperature and battery always belong together
+struct Reading
+{
+    float temp;
+    float batteryStatus;
+    float probeTemps[MAX_READING_PROBES];
+    uint8_t probeCount;
+};
+
+// Seqlock around a single Reading. There must only be one publishing task, readers never wait for it,
+// they copy the reading again if it was published in the meantime.
+void publishReading(const Reading &reading);
+
+void readReading(Reading &reading);
@@ -0,0 +1,81 @@
+#include "ReportQueue.h"
+
+#include <stddef.h>
+
+bool enqueueReport(ReportQueue &queue, uint8_t target, float value, time_t time)
+{
+    bool dropped = false;
+    if (queue.count == CAPACITY_REPORT_QUEUE)
+    {
+        popReport(queue);
+        queue.dropped++;
+        dropped = true;
+    }
+
+    QueuedReport &report = queue.reports[(queue.first + queue.count) % CAPACITY_REPORT_QUEUE];
+    report.target = target;
+    report.value = value;
+    report.time = (uint32_t)time;
+    queue.count++;
+
+    return !dropped;
+}
+
+unsigned int dropStaleReports(ReportQueue &queue, time_t now)
+{
+    unsigned int stale = 0;
+    const QueuedReport *report;
+    while ((report = peekReport(queue)) != NULL && (uint32_t)now >= report->time && (uint32_t)now - report->time > MAX_SECS_REPORT_AGE)
+    {
+        popReport(queue);
+        queue.dropped++;
+        stale++;
+    }
+
+    return stale;
+}
+
+const QueuedReport *peekReport(const ReportQueue &queue)
+{
+    return queue.count > 0 ? &queue.reports[queue.first] : NULL;
+}
+
+void popReport(ReportQueue &queue)
+{
+    if (queue.count == 0)
+        return;
+
+    queue.first = (queue.first + 1) % CAPACITY_REPORT_QUEUE;
+    queue.count--;
+}
+
+bool isRetryDue(const ReportQueue &queue, time_t now)
+{
+    return queue.count > 0 && now >= queue.nextRetry;
+}
+
+uint32_t reportBackoffSecs(uint8_t failures, uint32_t random)
+{
+    uint32_t backoff = MIN_SECS_REPORT_BACKOFF;
+    for (uint8_t i = 1; i < failures && backoff < MAX_SECS_REPORT_BACKOFF; i++)
+        backoff *= 2;
+    if (backoff > MAX_SECS_REPORT_BACKOFF)
+        backoff = MAX_SECS_REPORT_BACKOFF;
+
+    uint32_t jitter = backoff / 4;
+    return backoff - jitter + random % (2 * jitter + 1);
+}
+
+void registerReportFailure(ReportQueue &queue, time_t now, uint32_t random)
+{
+    if (queue.failures < UINT8_MAX)
+        queue.failures++;
+
+    queue.nextRetry = now + reportBackoffSecs(queue.failures, random);
+}
+
+void registerReportSuccess(ReportQueue &queue)
+{
+    queue.failures = 0;
+    queue.nextRetry = 0;
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <stdint.h>
+#include <time.h>
+
+// Reports that could not be delivered, kept free of Arduino and ESP-IDF so it can be compiled and run on a host.
+// Plain data only, so it can be kept in RTC memory across deep sleep.
+
+const uint8_t CAPACITY_REPORT_QUEUE = 48;
+const uint32_t MIN_SECS_REPORT_BACKOFF = 60;
+const uint32_t MAX_SECS_REPORT_BACKOFF = 6 * 3600;
+// Receivers like openHAB take the time of arrival as the time of a value, so older values are no longer sent
+const uint32_t MAX_SECS_REPORT_AGE = 24 * 3600;
+
+// Targets below REPORT_TARGET_PROBES are fixed, the probes follow with their index
+enum ReportTarget
+{
+    REPORT_TARGET_TEMPERATURE,
+    REPORT_TARGET_BATTERY,
+    REPORT_TARGET_PROBES
+};
+
+struct QueuedReport
+{
+    uint8_t target;
+    float value;
+    // When the value was sampled, in the seconds of the device clock
+    uint32_t time;
+};
+
+// Ring buffer in delivery order, the oldest report is dropped when a new one does not fit
+struct ReportQueue
+{
+    QueuedReport reports[CAPACITY_REPORT_QUEUE];
+    uint8_t first;
+    uint8_t count;
+    uint8_t failures;
+    uint32_t dropped;
+    time_t nextRetry;
+};
+
+// Returns false if the oldest report had to be dropped
+bool enqueueReport(ReportQueue &queue, uint8_t target, float value, time_t time);
+
+// Drops the reports older than MAX_SECS_REPORT_AGE and returns how many. They are queued in the order they were
+// sampled, so they are all at the front. A clock that was set back in the meantime keeps them.
+unsigned int dropStaleReports(ReportQueue &queue, time_t now);
+
+// Oldest report or NULL if the queue is empty
+const QueuedReport *peekReport(const ReportQueue &queue);
+
+void popReport(ReportQueue &queue);
+
+bool isRetryDue(const ReportQueue &queue, time_t now);
+
+// Doubles the wait before the next retry, random spreads retries of several devices after a server restart
+void registerReportFailure(ReportQueue &queue, time_t now, uint32_t random);
+
+void registerReportSuccess(ReportQueue &queue);
+
+// Backoff after the given number of consecutive failures with up to 25 % jitter in both directions
+uint32_t reportBackoffSecs(uint8_t failures, uint32_t random);
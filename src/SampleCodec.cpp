@@ -0,0 +1,165 @@
+#include "SampleCodec.h"
+
+#include <math.h>
+#include <string.h>
+
+static int16_t toFixedPoint(float value, float scale, long min, long max)
+{
+    long fixed = lroundf(value * scale);
+    return (int16_t)(fixed < min ? min : (fixed > max ? max : fixed));
+}
+
+static int16_t toCentiDegrees(float temp)
+{
+    return toFixedPoint(temp, 100.0F, -32768L, 32767L);
+}
+
+static int16_t toPermille(float batteryStatus)
+{
+    return toFixedPoint(batteryStatus, 1000.0F, -1000L, 2000L);
+}
+
+static uint32_t zigZag(int32_t value)
+{
+    return ((uint32_t)value << 1) ^ (uint32_t)(value >> 31);
+}
+
+static int32_t unZigZag(uint32_t value)
+{
+    return (int32_t)(value >> 1) ^ -(int32_t)(value & 1);
+}
+
+static uint16_t writeVarint(uint8_t *out, uint32_t value)
+{
+    uint16_t length = 0;
+    while (value >= 0x80)
+    {
+        out[length++] = (uint8_t)(value | 0x80);
+        value >>= 7;
+    }
+    out[length++] = (uint8_t)value;
+
+    return length;
+}
+
+static bool readVarint(SampleReader &reader, uint32_t &value)
+{
+    value = 0;
+    for (uint8_t shift = 0; shift < 35; shift += 7)
+    {
+        if (reader.position >= reader.samples->length)
+            return false;
+
+        uint8_t byte = reader.samples->data[reader.position++];
+        value |= (uint32_t)(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0)
+            return true;
+    }
+
+    return false;
+}
+
+static void dropOldestGroup(EncodedSamples &samples)
+{
+    if (samples.count <= KEYFRAME_INTERVAL_SAMPLES)
+    {
+        clearSamples(samples);
+        return;
+    }
+
+    SampleReader reader;
+    Sample skipped;
+    beginDecoding(reader, samples);
+    for (uint16_t i = 0; i < KEYFRAME_INTERVAL_SAMPLES; i++)
+    {
+        decodeSample(reader, skipped);
+    }
+
+    // The remaining samples start with a keyframe again
+    memmove(samples.data, samples.data + reader.position, samples.length - reader.position);
+    samples.length -= reader.position;
+    samples.count -= KEYFRAME_INTERVAL_SAMPLES;
+}
+
+void clearSamples(EncodedSamples &samples)
+{
+    samples.length = 0;
+    samples.count = 0;
+}
+
+void encodeSample(EncodedSamples &samples, const Sample &sample)
+{
+    while (samples.length + MAX_BYTES_PER_SAMPLE > CAPACITY_ENCODED_SAMPLES)
+    {
+        dropOldestGroup(samples);
+    }
+
+    uint32_t time = (uint32_t)sample.time;
+    int16_t centiTemp = toCentiDegrees(sample.temp);
+    int16_t batteryPermille = toPermille(sample.batteryStatus);
+    uint8_t *out = samples.data + samples.length;
+
+    if (samples.count % KEYFRAME_INTERVAL_SAMPLES == 0)
+    {
+        samples.length += writeVarint(out, time);
+        samples.length += writeVarint(samples.data + samples.length, zigZag(centiTemp));
+        samples.length += writeVarint(samples.data + samples.length, zigZag(batteryPermille));
+    }
+    else
+    {
+        samples.length += writeVarint(out, time - samples.lastTime);
+        samples.length += writeVarint(samples.data + samples.length, zigZag((int32_t)centiTemp - samples.lastCentiTemp));
+        samples.length += writeVarint(samples.data + samples.length, zigZag((int32_t)batteryPermille - samples.lastBatteryPermille));
+    }
+
+    samples.count++;
+    samples.lastTime = time;
+    samples.lastCentiTemp = centiTemp;
+    samples.lastBatteryPermille = batteryPermille;
+}
+
+bool isSamplesNearlyFull(const EncodedSamples &samples, uint16_t marginSamples)
+{
+    return samples.length + marginSamples * MAX_BYTES_PER_SAMPLE > CAPACITY_ENCODED_SAMPLES;
+}
+
+void beginDecoding(SampleReader &reader, const EncodedSamples &samples)
+{
+    reader.samples = &samples;
+    reader.position = 0;
+    reader.index = 0;
+    reader.time = 0;
+    reader.centiTemp = 0;
+    reader.batteryPermille = 0;
+}
+
+bool decodeSample(SampleReader &reader, Sample &sample)
+{
+    uint32_t time;
+    uint32_t temp;
+    uint32_t battery;
+
+    if (reader.index >= reader.samples->count ||
+        !readVarint(reader, time) || !readVarint(reader, temp) || !readVarint(reader, battery))
+        return false;
+
+    if (reader.index % KEYFRAME_INTERVAL_SAMPLES == 0)
+    {
+        reader.time = time;
+        reader.centiTemp = unZigZag(temp);
+        reader.batteryPermille = unZigZag(battery);
+    }
+    else
+    {
+        reader.time += time;
+        reader.centiTemp += unZigZag(temp);
+        reader.batteryPermille += unZigZag(battery);
+    }
+    reader.index++;
+
+    sample.time = reader.time;
+    sample.temp = reader.centiTemp / 100.0F;
+    sample.batteryStatus = reader.batteryPermille / 1000.0F;
+
+    return true;
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <stdint.h>
+#include <time.h>
+
+const uint16_t CAPACITY_ENCODED_SAMPLES = 1024;
+const uint16_t KEYFRAME_INTERVAL_SAMPLES = 16;
+
+// Worst case of one sample: 5 bytes time + 3 bytes temperature + 2 bytes battery, whatever the signal looks like
+const uint16_t MAX_BYTES_PER_SAMPLE = 10;
+
+struct Sample
+{
+    time_t time;
+    float temp;
+    float batteryStatus;
+};
+
+// Samples as centi-degrees and battery per-mille, each one stored as zig-zag varints of the
+// difference to the previous sample. Every KEYFRAME_INTERVAL_SAMPLES an absolute keyframe starts
+// a new group, so the oldest group can be dropped without decoding the rest.
+// Plain data only, so it can be kept in RTC memory.
+struct EncodedSamples
+{
+    uint8_t data[CAPACITY_ENCODED_SAMPLES];
+    uint16_t length;
+    uint16_t count;
+    uint32_t lastTime;
+    int16_t lastCentiTemp;
+    int16_t lastBatteryPermille;
+};
+
+struct SampleReader
+{
+    const EncodedSamples *samples;
+    uint16_t position;
+    uint16_t index;
+    uint32_t time;
+    int16_t centiTemp;
+    int16_t batteryPermille;
+};
+
+void clearSamples(EncodedSamples &samples);
+
+// Drops the oldest group of samples if the new one would not fit anymore
+void encodeSample(EncodedSamples &samples, const Sample &sample);
+
+bool isSamplesNearlyFull(const EncodedSamples &samples, uint16_t marginSamples);
+
+void beginDecoding(SampleReader &reader, const EncodedSamples &samples);
+
+bool decodeSample(SampleReader &reader, Sample &sample);
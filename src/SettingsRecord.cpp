@@ -0,0 +1,48 @@
+#include "SettingsRecord.h"
+#include "Crc32.h"
+
+#include <string.h>
+
+static uint32_t settingsRecordCrc(const SettingsRecord &record)
+{
+    return computeCrc32(&record, offsetof(SettingsRecord, crc));
+}
+
+void clearSettingsRecord(SettingsRecord &record)
+{
+    memset(&record, 0, sizeof(SettingsRecord));
+}
+
+void sealSettingsRecord(SettingsRecord &record)
+{
+    record.magic = MAGIC_SETTINGS_RECORD;
+    record.version = SETTINGS_RECORD_VERSION;
+    record.size = sizeof(SettingsRecord);
+    record.crc = settingsRecordCrc(record);
+}
+
+bool isSettingsRecordValid(const SettingsRecord &record)
+{
+    return record.magic == MAGIC_SETTINGS_RECORD && record.version == SETTINGS_RECORD_VERSION &&
+           record.size == sizeof(SettingsRecord) && record.crc == settingsRecordCrc(record);
+}
+
+bool readSettingsRecord(const uint8_t *data, size_t length, SettingsRecord &record)
+{
+    if (length < offsetof(SettingsRecord, name) + sizeof(uint32_t) || length > sizeof(SettingsRecord))
+        return false;
+
+    // The CRC is always the last field, so it follows from the length of the stored record
+    uint32_t crc;
+    memcpy(&crc, data + length - sizeof(uint32_t), sizeof(uint32_t));
+
+    clearSettingsRecord(record);
+    memcpy(&record, data, length - sizeof(uint32_t));
+
+    if (record.magic != MAGIC_SETTINGS_RECORD || record.version == 0 || record.version > SETTINGS_RECORD_VERSION ||
+        record.size != length || crc != computeCrc32(data, length - sizeof(uint32_t)))
+        return false;
+
+    sealSettingsRecord(record);
+    return true;
+}
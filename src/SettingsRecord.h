@@ -0,0 +1,85 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Settings as a single record, kept free of Arduino and ESP-IDF so it can be compiled and run on a host.
+
+// Key of the record in the settings namespace of Preferences
+const char ID_SETTINGS_RECORD[] = "record";
+
+// Increased whenever the layout of SettingsRecord changes, older records are migrated on load
+const uint16_t SETTINGS_RECORD_VERSION = 5;
+const uint32_t MAGIC_SETTINGS_RECORD = 0x53455454;
+
+const size_t LENGTH_SETTING_NAME = 33;
+const size_t LENGTH_SETTING_ADDRESS = 129;
+const size_t LENGTH_SETTING_HOST = 65;
+const size_t LENGTH_SETTING_USER = 33;
+const size_t LENGTH_SETTING_PASSWORD = 65;
+const size_t LENGTH_SETTING_TOPIC = 97;
+const size_t LENGTH_SETTING_GROUP = 16;
+
+const unsigned int REPORTING_BACKEND_HTTP = 0;
+const unsigned int REPORTING_BACKEND_MQTT = 1;
+// Both send all values of a cycle including the buffered backlog in one POST to the batch address
+const unsigned int REPORTING_BACKEND_INFLUX = 2;
+const unsigned int REPORTING_BACKEND_JSON = 3;
+// Each reading as one datagram to a multicast group, nothing is connected or acknowledged
+const unsigned int REPORTING_BACKEND_MULTICAST = 4;
+
+// All settings as one fixed size record, stored as a single NVS blob and mirrored in RTC memory.
+// Strings are zero terminated and truncated to their field. New fields are only appended before the CRC,
+// so a record of an older version is a prefix of the current layout.
+struct SettingsRecord
+{
+    uint32_t magic;
+    uint16_t version;
+    uint16_t size;
+    char name[LENGTH_SETTING_NAME];
+    bool activateReporting;
+    char editAddress[LENGTH_SETTING_ADDRESS];
+    uint32_t intervalSecs;
+    bool passive;
+    bool reportBattery;
+    char reportBatteryAddress[LENGTH_SETTING_ADDRESS];
+    uint32_t sampleIntervalSecs;
+    uint32_t batchSize;
+    bool deadband;
+    float deadbandTemp;
+    float deadbandBattery;
+    uint32_t maxSilenceSecs;
+    uint32_t reportingBackend;
+    char mqttHost[LENGTH_SETTING_HOST];
+    uint32_t mqttPort;
+    char mqttUser[LENGTH_SETTING_USER];
+    char mqttPassword[LENGTH_SETTING_PASSWORD];
+    char mqttTopicTemp[LENGTH_SETTING_TOPIC];
+    char mqttTopicBattery[LENGTH_SETTING_TOPIC];
+    char mqttTopicDiagnostics[LENGTH_SETTING_TOPIC];
+    uint32_t mqttQos;
+    bool mqttCleanSession;
+    bool logReadings;
+    // Version 2
+    uint8_t temperatureResolution;
+    // Version 3
+    char batchAddress[LENGTH_SETTING_ADDRESS];
+    // Version 4
+    char multicastGroup[LENGTH_SETTING_GROUP];
+    uint32_t multicastPort;
+    // Version 5
+    char diagnosticsAddress[LENGTH_SETTING_ADDRESS];
+    uint32_t crc;
+};
+
+// Zeroes the record including its padding, so the CRC only depends on the values
+void clearSettingsRecord(SettingsRecord &record);
+
+// Sets magic, version and size and calculates the CRC
+void sealSettingsRecord(SettingsRecord &record);
+
+bool isSettingsRecordValid(const SettingsRecord &record);
+
+// Checks a record as it was read from NVS and upgrades records of older versions to the current layout.
+// Fields that are missing in older versions are zero.
+bool readSettingsRecord(const uint8_t *data, size_t length, SettingsRecord &record);
@@ -0,0 +1,90 @@
+#include "SettingsStore.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include "WakePolicy.h"
+
+static const char *const LEGACY_IDS[] = {ID_NAME, ID_ACTIVATE_REPORTING, ID_EDIT_ADDRESS, ID_INTERVAL_SECS, ID_PASSIVE,
+                                          ID_REPORT_BATTERY, ID_REPORT_BATTERY_ADDRESS, ID_SAMPLE_INTERVAL_SECS,
+                                          ID_BATCH_SIZE, ID_DEADBAND, ID_DEADBAND_TEMP, ID_DEADBAND_BATTERY,
+                                          ID_MAX_SILENCE_SECS, ID_REPORTING_BACKEND, ID_MQTT_HOST, ID_MQTT_PORT,
+                                          ID_MQTT_USER, ID_MQTT_PASSWORD, ID_MQTT_TOPIC_TEMP, ID_MQTT_TOPIC_BATTERY,
+                                          ID_MQTT_TOPIC_DIAGNOSTICS, ID_MQTT_QOS, ID_MQTT_CLEAN_SESSION, ID_LOG_READINGS};
+
+size_t loadSettingsRecord(Hal &hal, SettingsRecord &record)
+{
+    uint8_t data[sizeof(SettingsRecord)];
+    hal.beginPreferences(PREFS_NAME, true);
+    size_t length = hal.getBytes(ID_SETTINGS_RECORD, data, sizeof(data));
+    hal.endPreferences();
+
+    return length > 0 && readSettingsRecord(data, length, record) ? length : 0;
+}
+
+bool writeSettingsRecord(Hal &hal, const SettingsRecord &record)
+{
+    hal.beginPreferences(PREFS_NAME, false);
+    bool written = hal.putBytes(ID_SETTINGS_RECORD, &record, sizeof(SettingsRecord)) == sizeof(SettingsRecord);
+    hal.endPreferences();
+
+    return written;
+}
+
+// The default topics contain the name, so they follow it
+static void getDefaultTopic(Hal &hal, const char *key, const char *name, const char *suffix, char *buffer, size_t length)
+{
+    char fallback[LENGTH_SETTING_TOPIC];
+    snprintf(fallback, sizeof(fallback), "thermometer/%s/%s", name, suffix);
+    hal.getString(key, fallback, buffer, length);
+}
+
+void loadLegacySettings(Hal &hal, const char *defaultName, SettingsRecord &record)
+{
+    clearSettingsRecord(record);
+    hal.beginPreferences(PREFS_NAME, true);
+
+    hal.getString(ID_NAME, defaultName, record.name, sizeof(record.name));
+    record.activateReporting = hal.getBool(ID_ACTIVATE_REPORTING, false);
+    hal.getString(ID_EDIT_ADDRESS, "", record.editAddress, sizeof(record.editAddress));
+    record.intervalSecs = hal.getUInt(ID_INTERVAL_SECS, 1800);
+    record.passive = hal.getBool(ID_PASSIVE, false);
+    record.reportBattery = hal.getBool(ID_REPORT_BATTERY, false);
+    hal.getString(ID_REPORT_BATTERY_ADDRESS, "", record.reportBatteryAddress, sizeof(record.reportBatteryAddress));
+    record.sampleIntervalSecs = hal.getUInt(ID_SAMPLE_INTERVAL_SECS, 0);
+    record.batchSize = hal.getUInt(ID_BATCH_SIZE, 10);
+    record.deadband = hal.getBool(ID_DEADBAND, false);
+    record.deadbandTemp = hal.getFloat(ID_DEADBAND_TEMP, 0.2F);
+    record.deadbandBattery = hal.getFloat(ID_DEADBAND_BATTERY, 5.0F);
+    record.maxSilenceSecs = hal.getUInt(ID_MAX_SILENCE_SECS, 21600);
+    record.reportingBackend = hal.getUInt(ID_REPORTING_BACKEND, REPORTING_BACKEND_HTTP);
+    hal.getString(ID_MQTT_HOST, "", record.mqttHost, sizeof(record.mqttHost));
+    record.mqttPort = hal.getUInt(ID_MQTT_PORT, 1883);
+    hal.getString(ID_MQTT_USER, "", record.mqttUser, sizeof(record.mqttUser));
+    hal.getString(ID_MQTT_PASSWORD, "", record.mqttPassword, sizeof(record.mqttPassword));
+    getDefaultTopic(hal, ID_MQTT_TOPIC_TEMP, record.name, "temperature", record.mqttTopicTemp, sizeof(record.mqttTopicTemp));
+    getDefaultTopic(hal, ID_MQTT_TOPIC_BATTERY, record.name, "battery", record.mqttTopicBattery, sizeof(record.mqttTopicBattery));
+    getDefaultTopic(hal, ID_MQTT_TOPIC_DIAGNOSTICS, record.name, "diagnostics", record.mqttTopicDiagnostics, sizeof(record.mqttTopicDiagnostics));
+    record.mqttQos = hal.getUInt(ID_MQTT_QOS, 0);
+    record.mqttCleanSession = hal.getBool(ID_MQTT_CLEAN_SESSION, true);
+    record.logReadings = hal.getBool(ID_LOG_READINGS, false);
+    record.temperatureResolution = hal.getUInt(ID_TEMPERATURE_RESOLUTION, RESOLUTION_AUTOMATIC);
+    hal.getString(ID_BATCH_ADDRESS, "", record.batchAddress, sizeof(record.batchAddress));
+    hal.getString(ID_MULTICAST_GROUP, DEFAULT_MULTICAST_GROUP, record.multicastGroup, sizeof(record.multicastGroup));
+    record.multicastPort = hal.getUInt(ID_MULTICAST_PORT, DEFAULT_MULTICAST_PORT);
+    hal.getString(ID_DIAGNOSTICS_ADDRESS, "", record.diagnosticsAddress, sizeof(record.diagnosticsAddress));
+
+    hal.endPreferences();
+    sealSettingsRecord(record);
+}
+
+void removeLegacySettings(Hal &hal)
+{
+    hal.beginPreferences(PREFS_NAME, false);
+    for (const char *id : LEGACY_IDS)
+    {
+        if (hal.isKey(id))
+            hal.removeKey(id);
+    }
+    hal.endPreferences();
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <stddef.h>
+
+#include "Hal.h"
+#include "SettingsRecord.h"
+
+// Loading and storing the settings in Preferences, kept free of Arduino and ESP-IDF so it can be compiled and run on a
+// host. Older firmware stored one key per setting, those keys are also the names of the settings in the web API.
+
+const char PREFS_NAME[] = "settings";
+const char ID_NAME[] = "name";
+const char ID_ACTIVATE_REPORTING[] = "activateRep";
+const char ID_EDIT_ADDRESS[] = "editAddress";
+const char ID_INTERVAL_SECS[] = "intervalSecs";
+const char ID_PASSIVE[] = "passive";
+const char ID_REPORT_BATTERY[] = "activateRepBat";
+const char ID_REPORT_BATTERY_ADDRESS[] = "editAddressBat";
+const char ID_SAMPLE_INTERVAL_SECS[] = "sampleSecs";
+const char ID_BATCH_SIZE[] = "batchSize";
+const char ID_DEADBAND[] = "deadband";
+const char ID_DEADBAND_TEMP[] = "deadbandTemp";
+const char ID_DEADBAND_BATTERY[] = "deadbandBat";
+const char ID_MAX_SILENCE_SECS[] = "maxSilenceSecs";
+const char ID_REPORTING_BACKEND[] = "backend";
+const char ID_MQTT_HOST[] = "mqttHost";
+const char ID_MQTT_PORT[] = "mqttPort";
+const char ID_MQTT_USER[] = "mqttUser";
+const char ID_MQTT_PASSWORD[] = "mqttPassword";
+const char ID_MQTT_TOPIC_TEMP[] = "mqttTopicTemp";
+const char ID_MQTT_TOPIC_BATTERY[] = "mqttTopicBat";
+const char ID_MQTT_TOPIC_DIAGNOSTICS[] = "mqttTopicDiag";
+const char ID_MQTT_QOS[] = "mqttQos";
+const char ID_MQTT_CLEAN_SESSION[] = "mqttClean";
+const char ID_LOG_READINGS[] = "logReadings";
+const char ID_TEMPERATURE_RESOLUTION[] = "resolution";
+const char ID_BATCH_ADDRESS[] = "batchAddress";
+const char ID_MULTICAST_GROUP[] = "multicastGroup";
+const char ID_MULTICAST_PORT[] = "multicastPort";
+const char ID_DIAGNOSTICS_ADDRESS[] = "editAddressDiag";
+
+const char DEFAULT_MULTICAST_GROUP[] = "239.255.42.42";
+const unsigned int DEFAULT_MULTICAST_PORT = 4242;
+
+// Returns the length it was stored with, which is less than the current record for older layouts,
+// or 0 if there is no valid record
+size_t loadSettingsRecord(Hal &hal, SettingsRecord &record);
+
+bool writeSettingsRecord(Hal &hal, const SettingsRecord &record);
+
+// Reads the keys of older firmware into a sealed record, missing keys get the defaults of a new device
+void loadLegacySettings(Hal &hal, const char *defaultName, SettingsRecord &record);
+
+// Only called once the record is written, so a power loss in between keeps the old settings
+void removeLegacySettings(Hal &hal);
@@ -0,0 +1,109 @@
+#include "TemperatureCycle.h"
+
+static void startConversion(TemperatureCycle &cycle, Hal &hal)
+{
+    // The resolution is only kept in the scratchpad, see setupSensors()
+    if (hal.getResolution() != cycle.resolution)
+        hal.setResolution(cycle.resolution);
+
+    hal.requestTemperatures();
+    cycle.conversionMs = hal.millisToWaitForConversion(cycle.resolution);
+    cycle.stateSince = hal.millis();
+    cycle.state = TEMPERATURE_CONVERTING;
+}
+
+static void finishCycle(TemperatureCycle &cycle, Hal &hal, ResolutionStats &stats)
+{
+    cycle.state = TEMPERATURE_IDLE;
+
+    // Only cycles that started below full resolution save anything. They are compared to what full resolution
+    // conversions took on this bus, as probes often finish before the nominal 750 ms.
+    stats.lastResolution = cycle.resolution;
+    stats.lastSavedMs = 0;
+    if (cycle.cycleResolution < RESOLUTION_HIGH)
+    {
+        uint32_t referenceMs = stats.highConversionMs > 0 ? stats.highConversionMs : hal.millisToWaitForConversion(RESOLUTION_HIGH);
+        stats.lastSavedMs = (int32_t)referenceMs - (int32_t)cycle.cycleConversionMs;
+    }
+    stats.totalSavedMs += stats.lastSavedMs;
+    stats.cycles++;
+}
+
+static void observeHighConversion(ResolutionStats &stats, uint32_t conversionMs)
+{
+    stats.highConversionMs = stats.highConversionMs == 0 ? conversionMs : (stats.highConversionMs * 7 + conversionMs) / 8;
+}
+
+static TemperatureEvent collectTemperatures(TemperatureCycle &cycle, Hal &hal, const DeadbandSettings &deadband,
+                                            const ReportedValues &lastReported, ResolutionStats &stats)
+{
+    uint32_t conversionMs = hal.millis() - cycle.stateSince;
+    cycle.cycleConversionMs += conversionMs;
+
+    // One broadcast conversion was started for all probes, so each of them is only read by address
+    cycle.probeCount = hal.probeCount() < MAX_READING_PROBES ? hal.probeCount() : MAX_READING_PROBES;
+    cycle.allValid = cycle.probeCount > 0;
+    for (unsigned int i = 0; i < cycle.probeCount; i++)
+    {
+        cycle.temps[i] = hal.getTempC(i);
+        if (!isTempValid(cycle.temps[i]))
+            cycle.allValid = false;
+    }
+    cycle.tries++;
+
+    if (cycle.allValid && cycle.resolution == RESOLUTION_HIGH)
+        observeHighConversion(stats, conversionMs);
+
+    if (cycle.allValid && isNearReportThreshold(deadband, lastReported, cycle.temps[0], cycle.resolution))
+    {
+        // The deadband decision depends on this reading, so it is repeated at full resolution
+        cycle.resolution = RESOLUTION_HIGH;
+        startConversion(cycle, hal);
+        return TEMPERATURE_EVENT_REPEAT;
+    }
+
+    if (cycle.allValid || cycle.tries >= MAX_TRIES_TEMPERATURE)
+    {
+        finishCycle(cycle, hal, stats);
+        return TEMPERATURE_EVENT_FINISHED;
+    }
+
+    cycle.stateSince = hal.millis();
+    cycle.state = TEMPERATURE_RETRY_WAIT;
+    return TEMPERATURE_EVENT_RETRY;
+}
+
+void beginTemperatureCycle(TemperatureCycle &cycle, Hal &hal, uint8_t resolution)
+{
+    cycle.tries = 0;
+    cycle.cycleStart = hal.millis();
+    cycle.cycleConversionMs = 0;
+    cycle.resolution = resolution;
+    cycle.cycleResolution = resolution;
+    cycle.probeCount = 0;
+    cycle.allValid = false;
+    startConversion(cycle, hal);
+}
+
+TemperatureEvent stepTemperatureCycle(TemperatureCycle &cycle, Hal &hal, const DeadbandSettings &deadband,
+                                      const ReportedValues &lastReported, ResolutionStats &stats)
+{
+    uint32_t elapsed = hal.millis() - cycle.stateSince;
+
+    switch (cycle.state)
+    {
+    case TEMPERATURE_CONVERTING:
+        if (elapsed >= cycle.conversionMs || hal.isConversionComplete())
+            return collectTemperatures(cycle, hal, deadband, lastReported, stats);
+        break;
+    case TEMPERATURE_RETRY_WAIT:
+        // Backing off a little longer with every failed try
+        if (elapsed >= DELAY_MS_TEMPERATURE_RETRY * cycle.tries)
+            startConversion(cycle, hal);
+        break;
+    default:
+        break;
+    }
+
+    return TEMPERATURE_EVENT_NONE;
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <stdint.h>
+
+#include "Hal.h"
+#include "ReadingSnapshot.h"
+#include "WakePolicy.h"
+
+// Non-blocking conversion of all probes on the bus, kept free of Arduino and ESP-IDF so it can be compiled and run on a
+// host against a simulated bus. A cycle is started with beginTemperatureCycle() and advanced by calling
+// stepTemperatureCycle() from a loop until it reports TEMPERATURE_EVENT_FINISHED.
+
+const int MAX_TRIES_TEMPERATURE = 5;
+const uint32_t DELAY_MS_TEMPERATURE_RETRY = 100;
+
+enum TemperatureState
+{
+    TEMPERATURE_IDLE,
+    TEMPERATURE_CONVERTING,
+    TEMPERATURE_RETRY_WAIT
+};
+
+// What a step did, every event but TEMPERATURE_EVENT_NONE means the probes were read into temps
+enum TemperatureEvent
+{
+    TEMPERATURE_EVENT_NONE,
+    // Not all probes answered, the conversion is tried again after a short wait
+    TEMPERATURE_EVENT_RETRY,
+    // The reading is close to the deadband threshold and converted again at full resolution
+    TEMPERATURE_EVENT_REPEAT,
+    // Either all probes were read or the tries are used up
+    TEMPERATURE_EVENT_FINISHED
+};
+
+// Plain data only, so it can be kept in RTC memory across deep sleep
+struct ResolutionStats
+{
+    uint8_t lastResolution;
+    int32_t lastSavedMs;
+    int32_t totalSavedMs;
+    uint32_t cycles;
+    // Smoothed duration of full resolution conversions as measured on this bus, 0 until there was one
+    uint32_t highConversionMs;
+};
+
+struct TemperatureCycle
+{
+    TemperatureState state;
+    uint32_t stateSince;
+    uint32_t conversionMs;
+    int tries;
+    uint32_t cycleStart;
+    uint8_t resolution;
+    // Resolution the cycle started with, before a conversion close to a threshold was repeated at full resolution
+    uint8_t cycleResolution;
+    uint32_t cycleConversionMs;
+    // Of the last try, -127 for probes that did not answer
+    unsigned int probeCount;
+    float temps[MAX_READING_PROBES];
+    bool allValid;
+};
+
+void beginTemperatureCycle(TemperatureCycle &cycle, Hal &hal, uint8_t resolution);
+
+// Returns right away, the deadband settings and the last report decide whether a reading is repeated at full resolution
+TemperatureEvent stepTemperatureCycle(TemperatureCycle &cycle, Hal &hal, const DeadbandSettings &deadband,
+                                      const ReportedValues &lastReported, ResolutionStats &stats);
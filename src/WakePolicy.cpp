@@ -0,0 +1,59 @@
+#include "WakePolicy.h"
+
+#include <math.h>
+
+bool isTempValid(float temp)
+{
+    return (temp > -30.0F && temp < 60.0F);
+}
+
+bool isReportDue(const DeadbandSettings &settings, const ReportedValues &lastReported, time_t now, bool tempValid, float temp, float batteryStatus)
+{
+    if (!settings.active || !lastReported.tempValid)
+        return true;
+
+    if (now - lastReported.time >= (time_t)settings.maxSilenceSecs)
+        return true;
+
+    if (tempValid && fabsf(temp - lastReported.temp) > settings.thresholdTemp)
+        return true;
+
+    // Battery threshold is configured in percentage points
+    if (settings.reportBattery && batteryStatus >= 0.0F &&
+        (!lastReported.batteryStatusValid || fabsf(batteryStatus - lastReported.batteryStatus) * 100.0F > settings.thresholdBatteryPercent))
+        return true;
+
+    return false;
+}
+
+bool isUploadDue(const BatchSettings &settings, const EncodedSamples &samples, time_t lastFlush, time_t now)
+{
+    return lastFlush == 0 ||
+           samples.count >= settings.batchSize ||
+           isSamplesNearlyFull(samples, settings.marginSamples) ||
+           now - lastFlush >= (time_t)settings.intervalSecs;
+}
+
+uint8_t chooseResolution(uint8_t setting, bool passive, bool deadband, bool liveViewers)
+{
+    if (setting != RESOLUTION_AUTOMATIC)
+        return setting < RESOLUTION_LOW ? RESOLUTION_LOW : (setting > RESOLUTION_HIGH ? RESOLUTION_HIGH : setting);
+
+    if (liveViewers)
+        return RESOLUTION_HIGH;
+
+    return passive || deadband ? RESOLUTION_LOW : RESOLUTION_HIGH;
+}
+
+float resolutionStep(uint8_t resolution)
+{
+    return 0.5F / (float)(1 << (resolution - RESOLUTION_LOW));
+}
+
+bool isNearReportThreshold(const DeadbandSettings &settings, const ReportedValues &lastReported, float temp, uint8_t resolution)
+{
+    if (!settings.active || !lastReported.tempValid || resolution >= RESOLUTION_HIGH)
+        return false;
+
+    return fabsf(fabsf(temp - lastReported.temp) - settings.thresholdTemp) <= resolutionStep(resolution);
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <stdint.h>
+#include <time.h>
+
+#include "SampleCodec.h"
+
+// Decisions of the wake cycle, kept free of Arduino and ESP-IDF so they can be compiled and run on a host.
+// All inputs are passed in, nothing is read from hardware or globals.
+
+struct DeadbandSettings
+{
+    bool active;
+    float thresholdTemp;
+    float thresholdBatteryPercent;
+    uint32_t maxSilenceSecs;
+    bool reportBattery;
+};
+
+// Values of the last successful report, compared against in deadband mode
+struct ReportedValues
+{
+    bool tempValid;
+    float temp;
+    bool batteryStatusValid;
+    float batteryStatus;
+    time_t time;
+};
+
+// 0 lets chooseResolution() decide, 9 to 12 bits are used as they are
+const uint8_t RESOLUTION_AUTOMATIC = 0;
+const uint8_t RESOLUTION_LOW = 9;
+const uint8_t RESOLUTION_HIGH = 12;
+
+struct BatchSettings
+{
+    unsigned int batchSize;
+    unsigned int intervalSecs;
+    uint16_t marginSamples;
+};
+
+// Readings outside of this range are wiring or bus errors, like the -127 of a probe that did not answer
+bool isTempValid(float temp);
+
+bool isReportDue(const DeadbandSettings &settings, const ReportedValues &lastReported, time_t now, bool tempValid, float temp, float batteryStatus);
+
+bool isUploadDue(const BatchSettings &settings, const EncodedSamples &samples, time_t lastFlush, time_t now);
+
+// Low resolution for passive and deadband wakes, where the conversion time is most of the time awake.
+// High resolution while someone is watching the live page or when the device is awake anyway.
+uint8_t chooseResolution(uint8_t setting, bool passive, bool deadband, bool liveViewers);
+
+// Degrees per step of the DS18B20 at the given resolution
+float resolutionStep(uint8_t resolution);
+
+// True if a reading at the given resolution is too close to the deadband threshold to decide on it
+bool isNearReportThreshold(const DeadbandSettings &settings, const ReportedValues &lastReported, float temp, uint8_t resolution);
@@ -5,407 +5,2726 @@
 #include <Preferences.h>
 #include <ArduinoJson.h>
 #include <HTTPClient.h>
+#include <WiFi.h>
+#include <AsyncMqttClient.h>
+#include <esp_adc_cal.h>
+#include <AsyncUDP.h>
+#include <ESPmDNS.h>
+#include <LittleFS.h>
 
+#include "Hal.h"
+#include "SampleCodec.h"
+#include "ReadingLog.h"
+#include "WakePolicy.h"
+#include "TemperatureCycle.h"
+#include "PhaseTimings.h"
+#include "SettingsRecord.h"
+#include "SettingsStore.h"
+#include "ProbeTable.h"
+#include "BatteryLevel.h"
+#include "ReadingSnapshot.h"
+#include "ReportQueue.h"
+#include "AsyncHttp.h"
+#include "BatchPayload.h"
+#include "ReadingDatagram.h"
 #include "web/RootPage.h"
 #include "web/SettingsPage.h"
 
-const char PREFS_NAME[] = "settings";
-const char ID_NAME[] = "name";
-const char ID_ACTIVATE_REPORTING[] = "activateRep";
-const char ID_EDIT_ADDRESS[] = "editAddress";
-const char ID_INTERVAL_SECS[] = "intervalSecs";
-const char ID_PASSIVE[] = "passive";
-const char ID_REPORT_BATTERY[] = "activateRepBat";
-const char ID_REPORT_BATTERY_ADDRESS[] = "editAddressBat";
+// Timer wakes in passive mode never start Serial, so their messages are not even built
+bool serialStarted = false;
+#define LOG_LINE(message) do { if (serialStarted) Serial.println(message); } while (0)
+
+const char ID_PROBES[] = "probes";
+const char ID_PROBE_TEMP[] = "temp";
 
 const unsigned int TIMES_HALL_READ = 10;
 const unsigned int DELAY_MS_HALL_READ = 100;
 const unsigned int THRESHOLD_HALL = 30;
-const int NUMBER_SAMPLES_BATTERY = 3;
+const uint32_t VREF_MV_DEFAULT = 1100;
+// The battery is connected through a 1:1 voltage divider
+const float RATIO_BATTERY_DIVIDER = 2.0F;
 const int DATA_PIN_THERMOMETER = 5;
 const int PIN_BATTERY_MONITORING = 35;
+const uint32_t MAGIC_WIFI_CACHE = 0x57494643;
+const uint32_t MAGIC_PROBE_MIRROR = 0x50524f42;
+const unsigned long TIMEOUT_MS_WIFI_FAST_CONNECT = 3000;
+const unsigned long MAX_SECS_WIFI_CACHE = 6 * 3600;
+const unsigned int MARGIN_SAMPLE_BUFFER_FULL = 4;
+const unsigned int MAX_REPORTING_HOSTS = 4;
+const unsigned int MAX_LENGTH_DNS_HOST = 64;
+const unsigned long MAX_SECS_DNS_CACHE = 3600;
+const unsigned long TIMEOUT_MS_MQTT = 3000;
+const unsigned int CAPACITY_HISTORY = 720;
+const unsigned long HISTORY_INTERVAL_MS = 60000;
+const char HISTORY_CSV_HEADER[] = "time,temp,battery\n";
+const size_t LENGTH_HISTORY_LINE = 26;
+const char LOG_CSV_HEADER[] = "sequence,time,temp,battery\n";
+const size_t MAX_LOG_RECORDS_PER_CHUNK = 16;
+const uint8_t HISTOGRAM_BOUNDS = 7;
+const uint32_t PUT_DURATION_BOUNDS_MS[HISTOGRAM_BOUNDS] = {50, 100, 250, 500, 1000, 2500, 5000};
+const uint32_t LOOP_DURATION_BOUNDS_MS[HISTOGRAM_BOUNDS] = {1, 2, 5, 10, 25, 50, 100};
+const uint8_t MAX_STATUS_CODES = 8;
+const size_t MAX_SIZE_SETTINGS_BODY = 4096;
+const size_t SIZE_SETTINGS_DOCUMENT = 6144;
+const unsigned long DELAY_MS_RESTART = 300;
+const unsigned long MAX_MS_REPORT_QUEUE_DRAIN = 5000;
+const uint32_t TIMEOUT_MS_REPORT_CONNECT = 2000;
+const uint32_t TIMEOUT_MS_REPORT_TOTAL = 5000;
+const uint32_t STACK_SIZE_SAMPLING_TASK = 4096;
+const uint32_t STACK_SIZE_REPORTING_TASK = 8192;
+const BaseType_t CORE_SAMPLING_TASK = 1;
+const BaseType_t CORE_REPORTING_TASK = 0;
+const TickType_t TICKS_SAMPLING_IDLE = pdMS_TO_TICKS(10);
+const TickType_t TICKS_REPORTING_WAIT = pdMS_TO_TICKS(100);
+const size_t SIZE_BATCH_BUFFER = 8192;
+const char NTP_SERVER[] = "pool.ntp.org";
+const unsigned long TIMEOUT_MS_CLOCK_SYNC = 3000;
+const unsigned long DELAY_MS_DATAGRAM_SENT = 20;
+
+AsyncWebServer *webServer = NULL;
+AsyncEventSource *events = NULL;
+OneWire oneWire(DATA_PIN_THERMOMETER);
+DallasTemperature sensors(&oneWire);
+
+// Every probe has a slot in the readings of the log and the reports
+static_assert(MAX_PROBES <= MAX_READING_PROBES, "More probes than a reading holds");
+
+// ROM addresses are enumerated once and cached in NVS, the first probe is the main thermometer
+Probe probes[MAX_PROBES];
+unsigned int probeCount = 0;
+
+float currentTemp = -127.0F;
+float currentBatteryStatus = -1.0F;
+
+String settingSensorName;
+bool settingActivateReporting;
+String settingEditAddress;
+unsigned int settingIntervalSecs;
+bool settingPassive;
+bool settingReportBattery;
+String settingReportBatteryAddress;
+unsigned int settingSampleIntervalSecs;
+unsigned int settingBatchSize;
+bool settingDeadband;
+float settingDeadbandTemp;
+float settingDeadbandBattery;
+unsigned int settingMaxSilenceSecs;
+unsigned int settingReportingBackend;
+String settingMqttHost;
+unsigned int settingMqttPort;
+String settingMqttUser;
+String settingMqttPassword;
+String settingMqttTopicTemp;
+String settingMqttTopicBattery;
+String settingMqttTopicDiagnostics;
+unsigned int settingMqttQos;
+bool settingMqttCleanSession;
+bool settingLogReadings;
+unsigned int settingTemperatureResolution;
+String settingBatchAddress;
+String settingDiagnosticsAddress;
+String settingMulticastGroup;
+unsigned int settingMulticastPort;
+
+unsigned long millisStart;
+
+// Settings posted to the web server, only taken over by applyChangedSettings() on the task that owns the settings
+struct ProbeEdit
+{
+    char rom[LENGTH_ROM_STRING];
+    char name[LENGTH_SETTING_NAME];
+    char reportAddress[LENGTH_SETTING_ADDRESS];
+};
+
+SettingsRecord pendingSettings;
+ProbeEdit pendingProbeEdits[MAX_PROBES];
+unsigned int pendingProbeEditCount = 0;
+volatile bool settingsChanged = false;
+volatile unsigned long restartRequestedAt = 0;
+// Guards the pending settings and settingsMirror, which the web server reads instead of the globals
+portMUX_TYPE settingsMux = portMUX_INITIALIZER_UNLOCKED;
+
+// What the sampling task needs of the settings and of the last report. The reporting task owns both and
+// publishes a copy under settingsMux, the sampling task only works on its own copy of it.
+struct SamplingSettings
+{
+    DeadbandSettings deadband;
+    ReportedValues lastReported;
+    uint8_t temperatureResolution;
+};
+
+SamplingSettings publishedSamplingSettings;
+SamplingSettings samplingSettings;
+unsigned long millisWifiStart;
+unsigned long millisWifiDone;
+bool wifiFromCache = false;
+
+// Connection data of the last successful association, kept in RTC slow memory across deep sleep
+struct WifiCache
+{
+    uint32_t magic;
+    char ssid[33];
+    char password[65];
+    uint8_t bssid[6];
+    int32_t channel;
+    uint32_t ip;
+    uint32_t gateway;
+    uint32_t subnet;
+    uint32_t dns;
+    time_t storedAt;
+};
+
+RTC_DATA_ATTR WifiCache wifiCache;
+
+// Copy of the stored settings, so wakes from deep sleep do not have to read NVS
+RTC_DATA_ATTR SettingsRecord settingsMirror;
+
+// Same for the probe table, written whenever it is saved to NVS
+struct ProbeMirror
+{
+    uint32_t magic;
+    uint32_t count;
+    Probe probes[MAX_PROBES];
+};
+
+RTC_DATA_ATTR ProbeMirror probeMirror;
+
+// Buckets are not cumulative here, the last one counts everything above the highest bound
+struct Histogram
+{
+    uint32_t buckets[HISTOGRAM_BOUNDS + 1];
+    uint32_t count;
+    uint64_t sumMs;
+};
+
+struct StatusCodeCounter
+{
+    int code;
+    uint32_t count;
+};
+
+// Counters exposed on /metrics, each one is only written from a single task
+struct Metrics
+{
+    uint32_t sensorReads;
+    uint32_t sensorInvalidReads;
+    StatusCodeCounter putStatusCodes[MAX_STATUS_CODES];
+    uint32_t putOtherStatusCodes;
+    Histogram putDuration;
+    Histogram loopDuration;
+};
+
+Metrics metrics;
+
+// Durations of the boot and reporting phases over the last wakes
+RTC_DATA_ATTR PhaseTimings phaseTimings;
+
+// Readings taken on sampling wakes without WiFi, uploaded together on the next reporting wake
+struct SampleBuffer
+{
+    EncodedSamples samples;
+    time_t lastFlush;
+};
+
+RTC_DATA_ATTR SampleBuffer sampleBuffer;
+
+// Counts across deep sleep, so collectors can tell lost datagrams from a restart
+RTC_DATA_ATTR uint16_t datagramSequence = 0;
+AsyncUDP udp;
+
+// Payload of batch uploads, written in place and reused for every POST
+char batchBuffer[SIZE_BATCH_BUFFER];
+
+// Readings of the last hours for the chart on the root page, the newest is at (historyTotal - 1) % CAPACITY_HISTORY
+Sample history[CAPACITY_HISTORY];
+unsigned long historyTotal = 0;
+
+RTC_DATA_ATTR ReportedValues lastReported;
+
+// Failed reports are retried with backoff on later cycles and wakes instead of being lost
+RTC_DATA_ATTR ReportQueue reportQueue;
+
+// Conversion time saved by the resolution policy compared to always converting at 12 bit
+RTC_DATA_ATTR ResolutionStats resolutionStats;
+
+// Resolved reporting hosts, kept across deep sleep so passive wakes skip the DNS lookup
+struct DnsCacheEntry
+{
+    char host[MAX_LENGTH_DNS_HOST];
+    uint32_t ip;
+    time_t resolvedAt;
+};
+
+RTC_DATA_ATTR DnsCacheEntry dnsCache[MAX_REPORTING_HOSTS];
+
+AsyncMqttClient mqttClient;
+String mqttClientId;
+// Updated from the async TCP task
+volatile bool mqttConnected = false;
+volatile unsigned int mqttPendingAcks = 0;
+
+int requestAddress(const char *method, const String &address, const char *contentType, const char *body, size_t length);
+
+// Matches the ADC configuration of setup(), the reference voltage is taken from eFuse when it was burned
+esp_adc_cal_characteristics_t adcCharacteristics;
+bool adcCharacterized = false;
+
+// The hardware behind the HAL, probes are read by the ROM address they were enumerated with
+class EspHal : public Hal
+{
+public:
+    uint32_t millis() override { return ::millis(); }
+    uint32_t micros() override { return ::micros(); }
+    void delay(uint32_t ms) override { ::delay(ms); }
+    time_t time() override { return ::time(NULL); }
+    uint32_t random() override { return esp_random(); }
+
+    unsigned int probeCount() override { return ::probeCount; }
+    uint8_t getResolution() override { return sensors.getResolution(); }
+    void setResolution(uint8_t resolution) override { sensors.setResolution(resolution); }
+    uint32_t millisToWaitForConversion(uint8_t resolution) override { return sensors.millisToWaitForConversion(resolution); }
+    void requestTemperatures() override { sensors.requestTemperatures(); }
+    bool isConversionComplete() override { return sensors.isConversionComplete(); }
+    float getTempC(unsigned int probe) override { return sensors.getTempC(probes[probe].rom); }
+    void resetBusSearch() override { oneWire.reset_search(); }
+    bool searchBus(uint8_t *rom) override { return oneWire.search(rom); }
+
+    uint16_t analogReadBattery() override { return analogRead(PIN_BATTERY_MONITORING); }
+
+    uint32_t batteryMillivoltsFrom(uint32_t raw) override
+    {
+        if (!adcCharacterized)
+        {
+            esp_adc_cal_characterize(ADC_UNIT_1, ADC_ATTEN_DB_11, ADC_WIDTH_BIT_11, VREF_MV_DEFAULT, &adcCharacteristics);
+            adcCharacterized = true;
+        }
+
+        return esp_adc_cal_raw_to_voltage(raw, &adcCharacteristics) * RATIO_BATTERY_DIVIDER;
+    }
+
+    bool beginPreferences(const char *space, bool readOnly) override { return prefs.begin(space, readOnly); }
+    void endPreferences() override { prefs.end(); }
+    bool isKey(const char *key) override { return prefs.isKey(key); }
+    bool getBool(const char *key, bool fallback) override { return prefs.getBool(key, fallback); }
+    uint32_t getUInt(const char *key, uint32_t fallback) override { return prefs.getUInt(key, fallback); }
+    float getFloat(const char *key, float fallback) override { return prefs.getFloat(key, fallback); }
+
+    // Read as a String, since reading into a buffer fails for longer values instead of truncating them
+    void getString(const char *key, const char *fallback, char *buffer, size_t length) override
+    {
+        strlcpy(buffer, prefs.getString(key, fallback).c_str(), length);
+    }
+
+    size_t getBytes(const char *key, void *buffer, size_t length) override
+    {
+        size_t stored = prefs.isKey(key) ? prefs.getBytesLength(key) : 0;
+        if (stored > length || (stored > 0 && prefs.getBytes(key, buffer, stored) != stored))
+            stored = 0;
+
+        return stored;
+    }
+
+    size_t putUInt(const char *key, uint32_t value) override { return prefs.putUInt(key, value); }
+    size_t putString(const char *key, const char *value) override { return prefs.putString(key, value); }
+    size_t putBytes(const char *key, const void *data, size_t length) override { return prefs.putBytes(key, data, length); }
+    bool removeKey(const char *key) override { return prefs.remove(key); }
+    bool clearPreferences() override { return prefs.clear(); }
+
+    bool mountFiles() override
+    {
+        if (LittleFS.begin(true))
+            return true;
+
+        LOG_LINE("Could not mount LittleFS for the reading log!");
+        return false;
+    }
+
+    bool makeDirectory(const char *path) override { return LittleFS.exists(path) || LittleFS.mkdir(path); }
+
+    bool listFiles(const char *directory, FileVisitor visit, void *context) override
+    {
+        File opened = LittleFS.open(directory);
+        if (!opened || !opened.isDirectory())
+            return false;
+
+        for (File file = opened.openNextFile(); file; file = opened.openNextFile())
+            visit(file.name(), file.size(), context);
+
+        return true;
+    }
+
+    size_t appendFile(const char *path, const void *data, size_t length) override
+    {
+        File file = LittleFS.open(path, "a");
+        return file ? file.write((const uint8_t *)data, length) : 0;
+    }
+
+    size_t readFile(const char *path, size_t offset, void *buffer, size_t length) override
+    {
+        File file = LittleFS.open(path, "r");
+        if (!file || !file.seek(offset))
+            return 0;
+
+        return file.read((uint8_t *)buffer, length);
+    }
+
+    bool removeFile(const char *path) override { return LittleFS.remove(path); }
+
+    int sendRequest(const char *method, const char *address, const char *contentType, const char *body, size_t length) override
+    {
+        return requestAddress(method, String(address), contentType, body, length);
+    }
+
+    void deepSleep(uint64_t micros) override
+    {
+        esp_sleep_enable_timer_wakeup(micros);
+        esp_deep_sleep_start();
+    }
+
+private:
+    // Opened by beginPreferences(), one namespace at a time
+    Preferences prefs;
+};
+
+EspHal hal;
+
+String getShortMac()
+{
+    uint8_t mac[6];
+    esp_read_mac(mac, ESP_MAC_WIFI_STA);
+
+    String macStringLastPart = "";
+    for (int i = 4; i < 6; i++)
+    {
+        macStringLastPart += String(mac[i], HEX);
+    }
+
+    return macStringLastPart;
+}
+
+bool isBatchSampling()
+{
+    return settingPassive && settingSampleIntervalSecs > 0;
+}
+
+void endPhase(Phase phase, unsigned long start)
+{
+    recordPhase(phaseTimings, phase, hal.millis() - start);
+}
+
+void initiateDeepSleepForReporting()
+{
+    endPhase(PHASE_AWAKE, millisStart);
+
+    unsigned int sleepSecs = isBatchSampling() ? settingSampleIntervalSecs : settingIntervalSecs;
+    hal.deepSleep((uint64_t)sleepSecs * 1000 * 1000);
+}
+
+void storeWifiCache()
+{
+    String ssid = WiFi.SSID();
+    String password = WiFi.psk();
+    if (ssid.length() >= sizeof(wifiCache.ssid) || password.length() >= sizeof(wifiCache.password))
+    {
+        wifiCache.magic = 0;
+        return;
+    }
+
+    strcpy(wifiCache.ssid, ssid.c_str());
+    strcpy(wifiCache.password, password.c_str());
+    memcpy(wifiCache.bssid, WiFi.BSSID(), sizeof(wifiCache.bssid));
+    wifiCache.channel = WiFi.channel();
+    wifiCache.ip = (uint32_t)WiFi.localIP();
+    wifiCache.gateway = (uint32_t)WiFi.gatewayIP();
+    wifiCache.subnet = (uint32_t)WiFi.subnetMask();
+    wifiCache.dns = (uint32_t)WiFi.dnsIP();
+    wifiCache.storedAt = hal.time();
+    wifiCache.magic = MAGIC_WIFI_CACHE;
+}
+
+bool connectWifiFromCache()
+{
+    // The address was never leased via DHCP again, so the cache is dropped regularly to renew it
+    if (wifiCache.magic != MAGIC_WIFI_CACHE || hal.time() - wifiCache.storedAt > MAX_SECS_WIFI_CACHE)
+        return false;
+
+    WiFi.persistent(false);
+    WiFi.mode(WIFI_STA);
+    WiFi.setHostname((String("Thermometer-") + settingSensorName).c_str());
+    WiFi.config(IPAddress(wifiCache.ip), IPAddress(wifiCache.gateway), IPAddress(wifiCache.subnet), IPAddress(wifiCache.dns));
+    WiFi.begin(wifiCache.ssid, wifiCache.password, wifiCache.channel, wifiCache.bssid);
+
+    unsigned long start = hal.millis();
+    while (WiFi.status() != WL_CONNECTED)
+    {
+        if (hal.millis() - start > TIMEOUT_MS_WIFI_FAST_CONNECT)
+        {
+            LOG_LINE("Could not reconnect with cached WiFi data!");
+            wifiCache.magic = 0;
+            WiFi.disconnect();
+            WiFi.config(INADDR_NONE, INADDR_NONE, INADDR_NONE);
+            return false;
+        }
+        hal.delay(5);
+    }
+
+    return true;
+}
+
+// A magnet held to the board for the duration of the check resets all settings
+bool checkHallForReset()
+{
+    int sum = 0;
+    for (unsigned int i = 0; i < TIMES_HALL_READ; i++)
+    {
+        sum += hallRead();
+        hal.delay(DELAY_MS_HALL_READ);
+    }
+
+    return abs(sum / (int)TIMES_HALL_READ) > (int)THRESHOLD_HALL;
+}
+
+DeadbandSettings deadbandSettings()
+{
+    DeadbandSettings deadband;
+    deadband.active = settingDeadband;
+    deadband.thresholdTemp = settingDeadbandTemp;
+    deadband.thresholdBatteryPercent = settingDeadbandBattery;
+    deadband.maxSilenceSecs = settingMaxSilenceSecs;
+    deadband.reportBattery = settingReportBattery;
+
+    return deadband;
+}
+
+// Called by the task that owns the settings whenever they or the last report changed
+void publishSamplingSettings()
+{
+    SamplingSettings published;
+    published.deadband = deadbandSettings();
+    published.lastReported = lastReported;
+    published.temperatureResolution = settingTemperatureResolution;
+
+    portENTER_CRITICAL(&settingsMux);
+    publishedSamplingSettings = published;
+    portEXIT_CRITICAL(&settingsMux);
+}
+
+// Called by the sampling side before it works with samplingSettings
+void takeSamplingSettings()
+{
+    portENTER_CRITICAL(&settingsMux);
+    samplingSettings = publishedSamplingSettings;
+    portEXIT_CRITICAL(&settingsMux);
+}
+
+void applySettingsRecord(const SettingsRecord &record)
+{
+    settingSensorName = record.name;
+    settingActivateReporting = record.activateReporting;
+    settingEditAddress = record.editAddress;
+    settingIntervalSecs = record.intervalSecs;
+    settingPassive = record.passive;
+    settingReportBattery = record.reportBattery;
+    settingReportBatteryAddress = record.reportBatteryAddress;
+    settingSampleIntervalSecs = record.sampleIntervalSecs;
+    settingBatchSize = record.batchSize;
+    settingDeadband = record.deadband;
+    settingDeadbandTemp = record.deadbandTemp;
+    settingDeadbandBattery = record.deadbandBattery;
+    settingMaxSilenceSecs = record.maxSilenceSecs;
+    settingReportingBackend = record.reportingBackend;
+    settingMqttHost = record.mqttHost;
+    settingMqttPort = record.mqttPort;
+    settingMqttUser = record.mqttUser;
+    settingMqttPassword = record.mqttPassword;
+    settingMqttTopicTemp = record.mqttTopicTemp;
+    settingMqttTopicBattery = record.mqttTopicBattery;
+    settingMqttTopicDiagnostics = record.mqttTopicDiagnostics;
+    settingMqttQos = record.mqttQos;
+    settingMqttCleanSession = record.mqttCleanSession;
+    settingLogReadings = record.logReadings;
+    settingTemperatureResolution = record.temperatureResolution;
+    settingBatchAddress = record.batchAddress;
+    // Records from before version 4 have these zeroed
+    settingMulticastGroup = record.multicastGroup[0] != '\0' ? record.multicastGroup : DEFAULT_MULTICAST_GROUP;
+    settingMulticastPort = record.multicastPort != 0 ? record.multicastPort : DEFAULT_MULTICAST_PORT;
+    settingDiagnosticsAddress = record.diagnosticsAddress;
+}
+
+void fillSettingsRecord(SettingsRecord &record)
+{
+    clearSettingsRecord(record);
+
+    strlcpy(record.name, settingSensorName.c_str(), sizeof(record.name));
+    record.activateReporting = settingActivateReporting;
+    strlcpy(record.editAddress, settingEditAddress.c_str(), sizeof(record.editAddress));
+    record.intervalSecs = settingIntervalSecs;
+    record.passive = settingPassive;
+    record.reportBattery = settingReportBattery;
+    strlcpy(record.reportBatteryAddress, settingReportBatteryAddress.c_str(), sizeof(record.reportBatteryAddress));
+    record.sampleIntervalSecs = settingSampleIntervalSecs;
+    record.batchSize = settingBatchSize;
+    record.deadband = settingDeadband;
+    record.deadbandTemp = settingDeadbandTemp;
+    record.deadbandBattery = settingDeadbandBattery;
+    record.maxSilenceSecs = settingMaxSilenceSecs;
+    record.reportingBackend = settingReportingBackend;
+    strlcpy(record.mqttHost, settingMqttHost.c_str(), sizeof(record.mqttHost));
+    record.mqttPort = settingMqttPort;
+    strlcpy(record.mqttUser, settingMqttUser.c_str(), sizeof(record.mqttUser));
+    strlcpy(record.mqttPassword, settingMqttPassword.c_str(), sizeof(record.mqttPassword));
+    strlcpy(record.mqttTopicTemp, settingMqttTopicTemp.c_str(), sizeof(record.mqttTopicTemp));
+    strlcpy(record.mqttTopicBattery, settingMqttTopicBattery.c_str(), sizeof(record.mqttTopicBattery));
+    strlcpy(record.mqttTopicDiagnostics, settingMqttTopicDiagnostics.c_str(), sizeof(record.mqttTopicDiagnostics));
+    record.mqttQos = settingMqttQos;
+    record.mqttCleanSession = settingMqttCleanSession;
+    record.logReadings = settingLogReadings;
+    record.temperatureResolution = settingTemperatureResolution;
+    strlcpy(record.batchAddress, settingBatchAddress.c_str(), sizeof(record.batchAddress));
+    strlcpy(record.multicastGroup, settingMulticastGroup.c_str(), sizeof(record.multicastGroup));
+    record.multicastPort = settingMulticastPort;
+    strlcpy(record.diagnosticsAddress, settingDiagnosticsAddress.c_str(), sizeof(record.diagnosticsAddress));
+
+    sealSettingsRecord(record);
+}
+
+void storeSettingsRecord(const SettingsRecord &record)
+{
+    writeSettingsRecord(hal, record);
+
+    portENTER_CRITICAL(&settingsMux);
+    settingsMirror = record;
+    portEXIT_CRITICAL(&settingsMux);
+}
+
+void saveSettings()
+{
+    SettingsRecord record;
+    fillSettingsRecord(record);
+    storeSettingsRecord(record);
+}
+
+void migrateSettings()
+{
+    LOG_LINE("Migrating settings to a single record...");
+    saveSettings();
+    removeLegacySettings(hal);
+}
+
+// Wakes from deep sleep use the RTC copy, NVS is only read after a cold boot
+void readSettings()
+{
+    if (isSettingsRecordValid(settingsMirror))
+    {
+        applySettingsRecord(settingsMirror);
+        return;
+    }
+
+    SettingsRecord record;
+    size_t length = loadSettingsRecord(hal, record);
+    if (length > 0)
+    {
+        applySettingsRecord(record);
+        settingsMirror = record;
+
+        // Stored again in the current layout, so the upgrade only happens once
+        if (length != sizeof(SettingsRecord))
+        {
+            LOG_LINE("Upgrading settings record...");
+            saveSettings();
+        }
+    }
+    else
+    {
+        // Settings were stored as one key per setting before the record, this also provides the defaults
+        loadLegacySettings(hal, getShortMac().c_str(), record);
+        applySettingsRecord(record);
+        migrateSettings();
+    }
+}
+
+String mqttSignature()
+{
+    return String(settingReportingBackend) + settingMqttHost + String(settingMqttPort) + settingMqttUser + settingMqttPassword + String(settingMqttCleanSession);
+}
+
+void resetSettings()
+{
+    const char *spaces[] = {PREFS_NAME, PREFS_NAME_PROBES};
+    for (const char *space : spaces)
+    {
+        hal.beginPreferences(space, false);
+        hal.clearPreferences();
+        hal.endPreferences();
+    }
+
+    clearSettingsRecord(settingsMirror);
+    probeMirror.magic = 0;
+}
+
+String romToString(const uint8_t *rom)
+{
+    char buffer[LENGTH_ROM_STRING];
+    formatRom(rom, buffer);
+
+    return String(buffer);
+}
+
+void readProbes()
+{
+    if (probeMirror.magic == MAGIC_PROBE_MIRROR && probeMirror.count <= MAX_PROBES)
+    {
+        probeCount = probeMirror.count;
+        for (unsigned int i = 0; i < probeCount; i++)
+        {
+            probes[i] = probeMirror.probes[i];
+            probes[i].temp = -127.0F;
+        }
+        return;
+    }
+
+    readStoredProbes(hal, probes, probeCount);
+}
+
+void saveProbes()
+{
+    writeStoredProbes(hal, probes, probeCount);
+
+    probeMirror.magic = MAGIC_PROBE_MIRROR;
+    probeMirror.count = probeCount;
+    for (unsigned int i = 0; i < probeCount; i++)
+    {
+        probeMirror.probes[i] = probes[i];
+    }
+}
+
+void findProbes()
+{
+    bool present[MAX_PROBES];
+    enumerateProbes(hal, probes, probeCount, present);
+
+    // A loose contact must not move the others up
+    for (unsigned int i = 0; i < probeCount; i++)
+    {
+        if (!present[i])
+            LOG_LINE(String("Probe '") + probes[i].name + String("' not found on the bus, keeping its slot"));
+    }
+
+    saveProbes();
+    LOG_LINE(String("Probes enumerated: ") + String(probeCount));
+}
+
+
+void sendGzippedPage(AsyncWebServerRequest *request, const uint8_t *page, size_t length, const char *etag)
+{
+    // Pages only change with the firmware, so browsers revalidate against the ETag and get a 304
+    if (request->hasHeader("If-None-Match") && request->header("If-None-Match") == etag)
+    {
+        request->send(304);
+        return;
+    }
+
+    AsyncWebServerResponse *response = request->beginResponse_P(200, "text/html", page, length);
+    response->addHeader("Content-Encoding", "gzip");
+    response->addHeader("ETag", etag);
+    response->addHeader("Cache-Control", "no-cache");
+    request->send(response);
+}
+
+void handleRootPage(AsyncWebServerRequest *request)
+{
+    sendGzippedPage(request, rootPage, rootPageLength, rootPageEtag);
+}
+
+void handleSettingsPage(AsyncWebServerRequest *request)
+{
+    sendGzippedPage(request, settingsPage, settingsPageLength, settingsPageEtag);
+}
+
+void handleGetTemperature(AsyncWebServerRequest *request)
+{
+    Reading reading;
+    readReading(reading);
+
+    if (isTempValid(reading.temp))
+        request->send(200, "text/plain", String(reading.temp));
+    else
+        request->send(500, "text/plain", "Temperature could not be determined!");
+}
+
+void handleGetTemperatures(AsyncWebServerRequest *request)
+{
+    Reading reading;
+    readReading(reading);
+
+    DynamicJsonDocument doc(64 + MAX_PROBES * 160);
+    JsonArray array = doc.to<JsonArray>();
+
+    for (unsigned int i = 0; i < probeCount; i++)
+    {
+        JsonObject probe = array.createNestedObject();
+        probe[ID_PROBE_ROM] = romToString(probes[i].rom);
+        probe[ID_PROBE_NAME] = probes[i].name;
+        if (i < reading.probeCount && isTempValid(reading.probeTemps[i]))
+            probe[ID_PROBE_TEMP] = reading.probeTemps[i];
+        else
+            probe[ID_PROBE_TEMP] = (char *)NULL;
+    }
+
+    String json;
+    serializeJson(doc, json);
+
+    request->send(200, "application/json", json);
+}
+
+size_t fillHistory(uint8_t *buffer, size_t maxLen, size_t index, unsigned long first, unsigned long end)
+{
+    // Every CSV line has the same length, so the position in the response maps directly to a sample
+    size_t headerLength = strlen(HISTORY_CSV_HEADER);
+    size_t written = 0;
+
+    while (written < maxLen)
+    {
+        size_t position = index + written;
+        char line[LENGTH_HISTORY_LINE + 1];
+        const char *source;
+        size_t offset;
+        size_t sourceLength;
+
+        if (position < headerLength)
+        {
+            source = HISTORY_CSV_HEADER;
+            sourceLength = headerLength;
+            offset = position;
+        }
+        else
+        {
+            unsigned long sampleIndex = first + (position - headerLength) / LENGTH_HISTORY_LINE;
+
+            // Stopping at the end of the snapshot or if the sample was overwritten in the meantime
+            if (sampleIndex >= end || sampleIndex + CAPACITY_HISTORY < historyTotal)
+                break;
+
+            const Sample &sample = history[sampleIndex % CAPACITY_HISTORY];
+            snprintf(line, sizeof(line), "%10ld,%7.2f,%6.1f\n",
+                     (long)sample.time,
+                     constrain(sample.temp, -99.99F, 999.99F),
+                     constrain(sample.batteryStatus * 100.0F, -1.0F, 999.9F));
+            source = line;
+            sourceLength = LENGTH_HISTORY_LINE;
+            offset = (position - headerLength) % LENGTH_HISTORY_LINE;
+        }
+
+        size_t length = min(sourceLength - offset, maxLen - written);
+        memcpy(buffer + written, source + offset, length);
+        written += length;
+    }
+
+    return written;
+}
+
+void handleGetHistory(AsyncWebServerRequest *request)
+{
+    unsigned long end = historyTotal;
+    unsigned long first = end > CAPACITY_HISTORY ? end - CAPACITY_HISTORY : 0;
+
+    request->send(request->beginChunkedResponse("text/csv", [first, end](uint8_t *buffer, size_t maxLen, size_t index) -> size_t {
+        return fillHistory(buffer, maxLen, index, first, end);
+    }));
+}
+
+struct LogExport
+{
+    uint32_t sequence;
+    char pending[48];
+    size_t pendingLength;
+    size_t pendingOffset;
+};
+
+size_t fillLogExport(LogExport &logExport, uint8_t *buffer, size_t maxLen)
+{
+    size_t written = 0;
+
+    while (written < maxLen)
+    {
+        // Finishing the line that did not fit into the previous chunk first
+        if (logExport.pendingOffset < logExport.pendingLength)
+        {
+            size_t length = min(logExport.pendingLength - logExport.pendingOffset, maxLen - written);
+            memcpy(buffer + written, logExport.pending + logExport.pendingOffset, length);
+            logExport.pendingOffset += length;
+            written += length;
+            continue;
+        }
+
+        LogRecord records[MAX_LOG_RECORDS_PER_CHUNK];
+        size_t count = readReadingLog(hal, logExport.sequence, records, min(MAX_LOG_RECORDS_PER_CHUNK, (maxLen - written) / 32 + 1));
+        if (count == 0)
+            break;
+
+        for (size_t i = 0; i < count; i++)
+        {
+            char line[sizeof(logExport.pending)];
+            int length = snprintf(line, sizeof(line), "%lu,%lu,%.2f,%.1f\n",
+                                  (unsigned long)records[i].sequence, (unsigned long)records[i].time,
+                                  records[i].temp, records[i].batteryStatus * 100.0F);
+
+            if (written + length <= maxLen)
+            {
+                memcpy(buffer + written, line, length);
+                written += length;
+            }
+            else
+            {
+                // Not read records are read again with the next chunk
+                size_t fitting = maxLen - written;
+                memcpy(buffer + written, line, fitting);
+                memcpy(logExport.pending, line, length);
+                logExport.pendingLength = length;
+                logExport.pendingOffset = fitting;
+                logExport.sequence = records[i].sequence + 1;
+                written = maxLen;
+                break;
+            }
+        }
+    }
+
+    return written;
+}
+
+void handleGetLog(AsyncWebServerRequest *request)
+{
+    if (!settingLogReadings)
+    {
+        request->send(404, "text/plain", "Reading log not active!");
+        return;
+    }
+
+    std::shared_ptr<LogExport> logExport(new LogExport());
+    logExport->sequence = request->hasParam("from") ? request->getParam("from")->value().toInt() : firstReadingLogSequence();
+    memcpy(logExport->pending, LOG_CSV_HEADER, strlen(LOG_CSV_HEADER));
+    logExport->pendingLength = strlen(LOG_CSV_HEADER);
+    logExport->pendingOffset = 0;
+
+    request->send(request->beginChunkedResponse("text/csv", [logExport](uint8_t *buffer, size_t maxLen, size_t index) -> size_t {
+        return fillLogExport(*logExport, buffer, maxLen);
+    }));
+}
+
+void addPhaseTimings(JsonObject object)
+{
+    for (int i = 0; i < PHASE_COUNT; i++)
+    {
+        PhaseSummary summary = summarizePhase(phaseTimings, (Phase)i);
+        if (summary.count == 0)
+            continue;
+
+        JsonObject phase = object.createNestedObject(phaseName((Phase)i));
+        phase["last"] = summary.last;
+        phase["min"] = summary.min;
+        phase["avg"] = summary.avg;
+        phase["max"] = summary.max;
+        phase["p95"] = summary.p95;
+        phase["count"] = summary.count;
+    }
+}
+
+void handleGetTimings(AsyncWebServerRequest *request)
+{
+    DynamicJsonDocument doc(128 + PHASE_COUNT * 160);
+    addPhaseTimings(doc.to<JsonObject>());
+
+    String json;
+    serializeJson(doc, json);
+
+    request->send(200, "application/json", json);
+}
+
+void observeHistogram(Histogram &histogram, const uint32_t *bounds, uint32_t valueMs)
+{
+    uint8_t bucket = 0;
+    while (bucket < HISTOGRAM_BOUNDS && valueMs > bounds[bucket])
+    {
+        bucket++;
+    }
+
+    histogram.buckets[bucket]++;
+    histogram.count++;
+    histogram.sumMs += valueMs;
+}
+
+void countStatusCode(int code)
+{
+    for (uint8_t i = 0; i < MAX_STATUS_CODES; i++)
+    {
+        if (metrics.putStatusCodes[i].count == 0)
+            metrics.putStatusCodes[i].code = code;
+
+        if (metrics.putStatusCodes[i].code == code)
+        {
+            metrics.putStatusCodes[i].count++;
+            return;
+        }
+    }
+
+    metrics.putOtherStatusCodes++;
+}
+
+void printMetricHeader(AsyncResponseStream *response, const char *name, const char *type, const char *help)
+{
+    response->printf("# HELP %s %s\n# TYPE %s %s\n", name, help, name, type);
+}
+
+void printHistogram(AsyncResponseStream *response, const char *name, const char *help, const Histogram &histogram, const uint32_t *bounds)
+{
+    printMetricHeader(response, name, "histogram", help);
+
+    uint32_t cumulative = 0;
+    for (uint8_t i = 0; i < HISTOGRAM_BOUNDS; i++)
+    {
+        cumulative += histogram.buckets[i];
+        response->printf("%s_bucket{le=\"%.3f\"} %u\n", name, bounds[i] / 1000.0F, cumulative);
+    }
+    response->printf("%s_bucket{le=\"+Inf\"} %u\n", name, histogram.count);
+    response->printf("%s_sum %.3f\n", name, histogram.sumMs / 1000.0);
+    response->printf("%s_count %u\n", name, histogram.count);
+}
+
+void handleGetMetrics(AsyncWebServerRequest *request)
+{
+    // Printed straight into the response buffer instead of concatenating Strings
+    AsyncResponseStream *response = request->beginResponseStream("text/plain; version=0.0.4");
+
+    printMetricHeader(response, "thermometer_sensor_reads_total", "counter", "Reads of temperature probes.");
+    response->printf("thermometer_sensor_reads_total %u\n", metrics.sensorReads);
+    printMetricHeader(response, "thermometer_sensor_invalid_reads_total", "counter", "Reads of temperature probes that returned no valid temperature.");
+    response->printf("thermometer_sensor_invalid_reads_total %u\n", metrics.sensorInvalidReads);
+
+    printMetricHeader(response, "thermometer_put_requests_total", "counter", "Reporting PUT requests by status code, negative codes are HTTPClient errors.");
+    for (uint8_t i = 0; i < MAX_STATUS_CODES && metrics.putStatusCodes[i].count > 0; i++)
+    {
+        response->printf("thermometer_put_requests_total{code=\"%d\"} %u\n", metrics.putStatusCodes[i].code, metrics.putStatusCodes[i].count);
+    }
+    if (metrics.putOtherStatusCodes > 0)
+        response->printf("thermometer_put_requests_total{code=\"other\"} %u\n", metrics.putOtherStatusCodes);
+
+    printHistogram(response, "thermometer_put_duration_seconds", "Duration of reporting HTTP requests.", metrics.putDuration, PUT_DURATION_BOUNDS_MS);
+    printHistogram(response, "thermometer_loop_duration_seconds", "Duration of sampling iterations without the idle delay.", metrics.loopDuration, LOOP_DURATION_BOUNDS_MS);
+
+    printMetricHeader(response, "thermometer_temperature_resolution_bits", "gauge", "Resolution of the last temperature conversion.");
+    response->printf("thermometer_temperature_resolution_bits %u\n", resolutionStats.lastResolution);
+    printMetricHeader(response, "thermometer_conversion_saved_seconds", "gauge", "Net conversion time saved across deep sleep compared to always converting at 12 bit.");
+    response->printf("thermometer_conversion_saved_seconds %.3f\n", resolutionStats.totalSavedMs / 1000.0);
+
+    printMetricHeader(response, "thermometer_report_queue_length", "gauge", "Failed reports waiting for a retry.");
+    response->printf("thermometer_report_queue_length %u\n", reportQueue.count);
+    printMetricHeader(response, "thermometer_report_queue_dropped_total", "counter", "Queued reports dropped because the queue was full, across deep sleep.");
+    response->printf("thermometer_report_queue_dropped_total %u\n", reportQueue.dropped);
+
+    printMetricHeader(response, "thermometer_heap_free_bytes", "gauge", "Free heap.");
+    response->printf("thermometer_heap_free_bytes %u\n", ESP.getFreeHeap());
+    printMetricHeader(response, "thermometer_heap_min_free_bytes", "gauge", "Lowest free heap since boot.");
+    response->printf("thermometer_heap_min_free_bytes %u\n", ESP.getMinFreeHeap());
+    printMetricHeader(response, "thermometer_wifi_rssi_dbm", "gauge", "WiFi signal strength.");
+    response->printf("thermometer_wifi_rssi_dbm %d\n", WiFi.RSSI());
+    printMetricHeader(response, "thermometer_uptime_seconds", "gauge", "Time since boot.");
+    response->printf("thermometer_uptime_seconds %.3f\n", hal.millis() / 1000.0);
+
+    Reading reading;
+    readReading(reading);
+
+    printMetricHeader(response, "thermometer_temperature_celsius", "gauge", "Last valid temperature of each probe.");
+    for (unsigned int i = 0; i < probeCount && i < reading.probeCount; i++)
+    {
+        if (isTempValid(reading.probeTemps[i]))
+            response->printf("thermometer_temperature_celsius{probe=\"%s\"} %.2f\n", probes[i].name, reading.probeTemps[i]);
+    }
+
+    if (settingReportBattery && reading.batteryStatus >= 0.0F)
+    {
+        printMetricHeader(response, "thermometer_battery_ratio", "gauge", "Battery level between 0 and 1.");
+        response->printf("thermometer_battery_ratio %.3f\n", reading.batteryStatus);
+    }
+
+    request->send(response);
+}
+
+void handleGetSettings(AsyncWebServerRequest *request)
+{
+    // The settings globals are only for the owning task, the web server works on a copy of the record
+    SettingsRecord record;
+    portENTER_CRITICAL(&settingsMux);
+    record = settingsMirror;
+    portEXIT_CRITICAL(&settingsMux);
+
+    DynamicJsonDocument doc(1280 + MAX_PROBES * 256);
+
+    doc[ID_NAME] = record.name;
+    doc[ID_ACTIVATE_REPORTING] = record.activateReporting;
+    doc[ID_EDIT_ADDRESS] = record.editAddress;
+    doc[ID_INTERVAL_SECS] = record.intervalSecs;
+    doc[ID_PASSIVE] = record.passive;
+    doc[ID_REPORT_BATTERY] = record.reportBattery;
+    doc[ID_REPORT_BATTERY_ADDRESS] = record.reportBatteryAddress;
+    doc[ID_SAMPLE_INTERVAL_SECS] = record.sampleIntervalSecs;
+    doc[ID_BATCH_SIZE] = record.batchSize;
+    doc[ID_DEADBAND] = record.deadband;
+    doc[ID_DEADBAND_TEMP] = record.deadbandTemp;
+    doc[ID_DEADBAND_BATTERY] = record.deadbandBattery;
+    doc[ID_MAX_SILENCE_SECS] = record.maxSilenceSecs;
+    doc[ID_REPORTING_BACKEND] = record.reportingBackend;
+    doc[ID_MQTT_HOST] = record.mqttHost;
+    doc[ID_MQTT_PORT] = record.mqttPort;
+    doc[ID_MQTT_USER] = record.mqttUser;
+    doc[ID_MQTT_PASSWORD] = record.mqttPassword;
+    doc[ID_MQTT_TOPIC_TEMP] = record.mqttTopicTemp;
+    doc[ID_MQTT_TOPIC_BATTERY] = record.mqttTopicBattery;
+    doc[ID_MQTT_TOPIC_DIAGNOSTICS] = record.mqttTopicDiagnostics;
+    doc[ID_MQTT_QOS] = record.mqttQos;
+    doc[ID_MQTT_CLEAN_SESSION] = record.mqttCleanSession;
+    doc[ID_LOG_READINGS] = record.logReadings;
+    doc[ID_TEMPERATURE_RESOLUTION] = record.temperatureResolution;
+    doc[ID_BATCH_ADDRESS] = record.batchAddress;
+    doc[ID_MULTICAST_GROUP] = record.multicastGroup;
+    doc[ID_MULTICAST_PORT] = record.multicastPort;
+    doc[ID_DIAGNOSTICS_ADDRESS] = record.diagnosticsAddress;
+
+    JsonArray probesArray = doc.createNestedArray(ID_PROBES);
+    for (unsigned int i = 0; i < probeCount; i++)
+    {
+        JsonObject probe = probesArray.createNestedObject();
+        probe[ID_PROBE_ROM] = romToString(probes[i].rom);
+        probe[ID_PROBE_NAME] = probes[i].name;
+        probe[ID_PROBE_ADDRESS] = probes[i].reportAddress;
+    }
+
+    String json;
+    serializeJson(doc, json);
+
+    request->send(200, "application/json", json);
+}
+
+bool collectBody(AsyncWebServerRequest *request, uint8_t *data, size_t len, size_t index, size_t total)
+{
+    // The body may arrive in several chunks, so it is collected until all of it is there.
+    // The buffer is freed together with the request. A body that is not collected is answered once the request is complete.
+    if (index == 0 && total <= MAX_SIZE_SETTINGS_BODY)
+        request->_tempObject = malloc(total);
+
+    if (request->_tempObject == NULL || index + len > total)
+        return false;
+
+    memcpy((uint8_t *)request->_tempObject + index, data, len);
+    return index + len == total;
+}
+
+// Returns the first string setting that does not fit into its field of the settings record
+const char *findTooLongSetting(JsonDocument &doc)
+{
+    struct
+    {
+        const char *id;
+        size_t length;
+    } limits[] = {{ID_NAME, LENGTH_SETTING_NAME},
+                  {ID_EDIT_ADDRESS, LENGTH_SETTING_ADDRESS},
+                  {ID_REPORT_BATTERY_ADDRESS, LENGTH_SETTING_ADDRESS},
+                  {ID_MQTT_HOST, LENGTH_SETTING_HOST},
+                  {ID_MQTT_USER, LENGTH_SETTING_USER},
+                  {ID_MQTT_PASSWORD, LENGTH_SETTING_PASSWORD},
+                  {ID_MQTT_TOPIC_TEMP, LENGTH_SETTING_TOPIC},
+                  {ID_MQTT_TOPIC_BATTERY, LENGTH_SETTING_TOPIC},
+                  {ID_MQTT_TOPIC_DIAGNOSTICS, LENGTH_SETTING_TOPIC},
+                  {ID_BATCH_ADDRESS, LENGTH_SETTING_ADDRESS},
+                  {ID_MULTICAST_GROUP, LENGTH_SETTING_GROUP},
+                  {ID_DIAGNOSTICS_ADDRESS, LENGTH_SETTING_ADDRESS}};
+
+    for (const auto &limit : limits)
+    {
+        const char *value = doc[limit.id];
+        if (value != NULL && strlen(value) >= limit.length)
+            return limit.id;
+    }
+
+    for (JsonObject probe : doc[ID_PROBES].as<JsonArray>())
+    {
+        const char *name = probe[ID_PROBE_NAME];
+        const char *address = probe[ID_PROBE_ADDRESS];
+        if (name != NULL && strlen(name) >= LENGTH_SETTING_NAME)
+            return ID_PROBE_NAME;
+        if (address != NULL && strlen(address) >= LENGTH_SETTING_ADDRESS)
+            return ID_PROBE_ADDRESS;
+    }
+
+    return NULL;
+}
+
+// Only IPv4 groups from 224.0.0.0/4 are accepted
+bool isMulticastGroup(const String &group)
+{
+    IPAddress ip;
+    return ip.fromString(group) && ip[0] >= 224 && ip[0] <= 239;
+}
+
+// Settings of a validated POST body as a record, without touching the settings globals
+void parseSettingsRecord(JsonDocument &doc, SettingsRecord &record)
+{
+    clearSettingsRecord(record);
+
+    strlcpy(record.name, doc[ID_NAME] | "", sizeof(record.name));
+    record.activateReporting = doc[ID_ACTIVATE_REPORTING];
+    strlcpy(record.editAddress, doc[ID_EDIT_ADDRESS] | "", sizeof(record.editAddress));
+    record.intervalSecs = doc[ID_INTERVAL_SECS];
+    record.passive = doc[ID_PASSIVE];
+    record.reportBattery = doc[ID_REPORT_BATTERY];
+    strlcpy(record.reportBatteryAddress, doc[ID_REPORT_BATTERY_ADDRESS] | "", sizeof(record.reportBatteryAddress));
+    record.sampleIntervalSecs = doc[ID_SAMPLE_INTERVAL_SECS];
+    record.batchSize = doc[ID_BATCH_SIZE];
+    record.deadband = doc[ID_DEADBAND];
+    record.deadbandTemp = doc[ID_DEADBAND_TEMP];
+    record.deadbandBattery = doc[ID_DEADBAND_BATTERY];
+    record.maxSilenceSecs = doc[ID_MAX_SILENCE_SECS];
+    record.reportingBackend = doc[ID_REPORTING_BACKEND];
+    strlcpy(record.mqttHost, doc[ID_MQTT_HOST] | "", sizeof(record.mqttHost));
+    record.mqttPort = doc[ID_MQTT_PORT];
+    strlcpy(record.mqttUser, doc[ID_MQTT_USER] | "", sizeof(record.mqttUser));
+    strlcpy(record.mqttPassword, doc[ID_MQTT_PASSWORD] | "", sizeof(record.mqttPassword));
+    strlcpy(record.mqttTopicTemp, doc[ID_MQTT_TOPIC_TEMP] | "", sizeof(record.mqttTopicTemp));
+    strlcpy(record.mqttTopicBattery, doc[ID_MQTT_TOPIC_BATTERY] | "", sizeof(record.mqttTopicBattery));
+    strlcpy(record.mqttTopicDiagnostics, doc[ID_MQTT_TOPIC_DIAGNOSTICS] | "", sizeof(record.mqttTopicDiagnostics));
+    record.mqttQos = doc[ID_MQTT_QOS];
+    record.mqttCleanSession = doc[ID_MQTT_CLEAN_SESSION];
+    record.logReadings = doc[ID_LOG_READINGS];
+    record.temperatureResolution = doc[ID_TEMPERATURE_RESOLUTION];
+    strlcpy(record.batchAddress, doc[ID_BATCH_ADDRESS] | "", sizeof(record.batchAddress));
+    strlcpy(record.multicastGroup, doc[ID_MULTICAST_GROUP] | "", sizeof(record.multicastGroup));
+    record.multicastPort = doc[ID_MULTICAST_PORT];
+    strlcpy(record.diagnosticsAddress, doc[ID_DIAGNOSTICS_ADDRESS] | "", sizeof(record.diagnosticsAddress));
+
+    sealSettingsRecord(record);
+}
+
+void handlePostSettings(AsyncWebServerRequest *request, uint8_t *data, size_t len, size_t index, size_t total)
+{
+    if (!collectBody(request, data, len, index, total))
+        return;
+
+    DynamicJsonDocument doc(SIZE_SETTINGS_DOCUMENT);
+    if (deserializeJson(doc, (const char *)request->_tempObject, total) != DeserializationError::Ok)
+    {
+        request->send(400, "text/plain", "Could not parse JSON!");
+    }
+    else if (!doc.containsKey(ID_NAME))
+        request->send(400, "text/plain", String(ID_NAME) + String(" missing!"));
+    else if (!doc.containsKey(ID_ACTIVATE_REPORTING))
+        request->send(400, "text/plain", String(ID_ACTIVATE_REPORTING) + String(" missing!"));
+    else if (!doc.containsKey(ID_EDIT_ADDRESS))
+        request->send(400, "text/plain", String(ID_EDIT_ADDRESS) + String(" missing!"));
+    else if (!doc.containsKey(ID_INTERVAL_SECS))
+        request->send(400, "text/plain", String(ID_INTERVAL_SECS) + String(" missing!"));
+    else if (!doc.containsKey(ID_PASSIVE))
+        request->send(400, "text/plain", String(ID_PASSIVE) + String(" missing!"));
+    else if (!doc.containsKey(ID_REPORT_BATTERY))
+        request->send(400, "text/plain", String(ID_REPORT_BATTERY) + String(" missing!"));
+    else if (!doc.containsKey(ID_REPORT_BATTERY_ADDRESS))
+        request->send(400, "text/plain", String(ID_REPORT_BATTERY_ADDRESS) + String(" missing!"));
+    else if (!doc.containsKey(ID_SAMPLE_INTERVAL_SECS))
+        request->send(400, "text/plain", String(ID_SAMPLE_INTERVAL_SECS) + String(" missing!"));
+    else if (!doc.containsKey(ID_BATCH_SIZE))
+        request->send(400, "text/plain", String(ID_BATCH_SIZE) + String(" missing!"));
+    else if (!doc.containsKey(ID_DEADBAND))
+        request->send(400, "text/plain", String(ID_DEADBAND) + String(" missing!"));
+    else if (!doc.containsKey(ID_DEADBAND_TEMP))
+        request->send(400, "text/plain", String(ID_DEADBAND_TEMP) + String(" missing!"));
+    else if (!doc.containsKey(ID_DEADBAND_BATTERY))
+        request->send(400, "text/plain", String(ID_DEADBAND_BATTERY) + String(" missing!"));
+    else if (!doc.containsKey(ID_MAX_SILENCE_SECS))
+        request->send(400, "text/plain", String(ID_MAX_SILENCE_SECS) + String(" missing!"));
+    else if (!doc.containsKey(ID_PROBES))
+        request->send(400, "text/plain", String(ID_PROBES) + String(" missing!"));
+    else if (!doc.containsKey(ID_REPORTING_BACKEND))
+        request->send(400, "text/plain", String(ID_REPORTING_BACKEND) + String(" missing!"));
+    else if (!doc.containsKey(ID_MQTT_HOST))
+        request->send(400, "text/plain", String(ID_MQTT_HOST) + String(" missing!"));
+    else if (!doc.containsKey(ID_MQTT_PORT))
+        request->send(400, "text/plain", String(ID_MQTT_PORT) + String(" missing!"));
+    else if (!doc.containsKey(ID_MQTT_USER))
+        request->send(400, "text/plain", String(ID_MQTT_USER) + String(" missing!"));
+    else if (!doc.containsKey(ID_MQTT_PASSWORD))
+        request->send(400, "text/plain", String(ID_MQTT_PASSWORD) + String(" missing!"));
+    else if (!doc.containsKey(ID_MQTT_TOPIC_TEMP))
+        request->send(400, "text/plain", String(ID_MQTT_TOPIC_TEMP) + String(" missing!"));
+    else if (!doc.containsKey(ID_MQTT_TOPIC_BATTERY))
+        request->send(400, "text/plain", String(ID_MQTT_TOPIC_BATTERY) + String(" missing!"));
+    else if (!doc.containsKey(ID_MQTT_TOPIC_DIAGNOSTICS))
+        request->send(400, "text/plain", String(ID_MQTT_TOPIC_DIAGNOSTICS) + String(" missing!"));
+    else if (!doc.containsKey(ID_MQTT_QOS))
+        request->send(400, "text/plain", String(ID_MQTT_QOS) + String(" missing!"));
+    else if (!doc.containsKey(ID_MQTT_CLEAN_SESSION))
+        request->send(400, "text/plain", String(ID_MQTT_CLEAN_SESSION) + String(" missing!"));
+    else if (!doc.containsKey(ID_LOG_READINGS))
+        request->send(400, "text/plain", String(ID_LOG_READINGS) + String(" missing!"));
+    else if (!doc.containsKey(ID_TEMPERATURE_RESOLUTION))
+        request->send(400, "text/plain", String(ID_TEMPERATURE_RESOLUTION) + String(" missing!"));
+    else if (!doc.containsKey(ID_BATCH_ADDRESS))
+        request->send(400, "text/plain", String(ID_BATCH_ADDRESS) + String(" missing!"));
+    else if (!doc.containsKey(ID_MULTICAST_GROUP))
+        request->send(400, "text/plain", String(ID_MULTICAST_GROUP) + String(" missing!"));
+    else if (!doc.containsKey(ID_MULTICAST_PORT))
+        request->send(400, "text/plain", String(ID_MULTICAST_PORT) + String(" missing!"));
+    else if (!doc.containsKey(ID_DIAGNOSTICS_ADDRESS))
+        request->send(400, "text/plain", String(ID_DIAGNOSTICS_ADDRESS) + String(" missing!"));
+    else if (findTooLongSetting(doc) != NULL)
+        request->send(400, "text/plain", String(findTooLongSetting(doc)) + String(" too long!"));
+    else if (doc[ID_TEMPERATURE_RESOLUTION] != RESOLUTION_AUTOMATIC && (doc[ID_TEMPERATURE_RESOLUTION] < RESOLUTION_LOW || doc[ID_TEMPERATURE_RESOLUTION] > RESOLUTION_HIGH))
+        request->send(400, "text/plain", String(ID_TEMPERATURE_RESOLUTION) + String(" invalid!"));
+    else if (doc[ID_REPORTING_BACKEND] > REPORTING_BACKEND_MULTICAST)
+        request->send(400, "text/plain", String(ID_REPORTING_BACKEND) + String(" invalid!"));
+    else if (!isMulticastGroup(doc[ID_MULTICAST_GROUP].as<String>()))
+        request->send(400, "text/plain", String(ID_MULTICAST_GROUP) + String(" invalid!"));
+    else if (doc[ID_MULTICAST_PORT] < 1 || doc[ID_MULTICAST_PORT] > 65535)
+        request->send(400, "text/plain", String(ID_MULTICAST_PORT) + String(" invalid!"));
+    else
+    {
+        SettingsRecord record;
+        parseSettingsRecord(doc, record);
+
+        // The host name and the boot mode are never changed live, so the web server may compare against them
+        bool restart = strcmp(record.name, settingSensorName.c_str()) != 0 || record.passive != settingPassive;
+
+        portENTER_CRITICAL(&settingsMux);
+        pendingSettings = record;
+        pendingProbeEditCount = 0;
+        for (JsonObject probe : doc[ID_PROBES].as<JsonArray>())
+        {
+            if (pendingProbeEditCount >= MAX_PROBES)
+                break;
+
+            ProbeEdit &edit = pendingProbeEdits[pendingProbeEditCount++];
+            strlcpy(edit.rom, probe[ID_PROBE_ROM] | "", sizeof(edit.rom));
+            strlcpy(edit.name, probe[ID_PROBE_NAME] | "", sizeof(edit.name));
+            strlcpy(edit.reportAddress, probe[ID_PROBE_ADDRESS] | "", sizeof(edit.reportAddress));
+        }
+        settingsChanged = true;
+        portEXIT_CRITICAL(&settingsMux);
+
+        if (restart)
+        {
+            request->send(200, "text/plain", "Restarting!");
+            restartRequestedAt = hal.millis();
+        }
+        else
+        {
+            request->send(200, "text/plain", "OK!");
+        }
+    }
+}
+
+// Called once the whole request is received, a collected body has already been answered by handlePostSettings()
+void handlePostSettingsRequest(AsyncWebServerRequest *request)
+{
+    if (request->_tempObject != NULL)
+        return;
+
+    if (request->contentLength() > MAX_SIZE_SETTINGS_BODY)
+        request->send(413, "text/plain", "Settings too large!");
+    else if (request->contentLength() > 0)
+        request->send(500, "text/plain", "Out of memory!");
+    else
+        request->send(400, "text/plain", "No data!");
+}
+
+// Makes the web pages reachable as Thermometer-<name>.local, only in active mode as passive devices are asleep
+void setupMdns()
+{
+    if (!MDNS.begin((String("Thermometer-") + settingSensorName).c_str()))
+    {
+        LOG_LINE("Could not start mDNS!");
+        return;
+    }
+
+    MDNS.addService("http", "tcp", 80);
+}
+
+void setupWebServer()
+{
+    webServer = new AsyncWebServer(80);
+
+    webServer->onNotFound([](AsyncWebServerRequest *request) { request->send(404, "text/plain", "Not found!"); });
+    webServer->on("/", HTTP_GET, [&](AsyncWebServerRequest *request) { handleRootPage(request); });
+    webServer->on("/settingsPage", HTTP_GET, [&](AsyncWebServerRequest *request) { handleSettingsPage(request); });
+    webServer->on("/settings", HTTP_GET, [&](AsyncWebServerRequest *request) { handleGetSettings(request); });
+    webServer->on("/settings", HTTP_POST,
+                  [&](AsyncWebServerRequest *request) -> void { handlePostSettingsRequest(request); },
+                  [](AsyncWebServerRequest *request, const String &filename, size_t index, uint8_t *data, size_t len, bool final) -> void { request->send(400, "text/plain", "Wrong data!"); },
+                  [&](AsyncWebServerRequest *request, uint8_t *data, size_t len, size_t index, size_t total) -> void { handlePostSettings(request, data, len, index, total); });
+    webServer->on("/temperature", HTTP_GET, [&](AsyncWebServerRequest *request) { handleGetTemperature(request); });
+    webServer->on("/temperatures", HTTP_GET, [&](AsyncWebServerRequest *request) { handleGetTemperatures(request); });
+    webServer->on("/history", HTTP_GET, [&](AsyncWebServerRequest *request) { handleGetHistory(request); });
+    webServer->on("/log", HTTP_GET, [&](AsyncWebServerRequest *request) { handleGetLog(request); });
+    webServer->on("/timings", HTTP_GET, [&](AsyncWebServerRequest *request) { handleGetTimings(request); });
+    webServer->on("/metrics", HTTP_GET, [&](AsyncWebServerRequest *request) { handleGetMetrics(request); });
+
+    // Live page subscribers get new readings pushed instead of polling /temperature
+    events = new AsyncEventSource("/events");
+    events->onConnect([](AsyncEventSourceClient *client) {
+        Reading reading;
+        readReading(reading);
+        if (isTempValid(reading.temp))
+            client->send(String(reading.temp).c_str(), "temperature", hal.millis());
+    });
+    webServer->addHandler(events);
+
+    webServer->begin();
+}
+
+TemperatureCycle temperatureCycle;
+bool temperatureReadCompleted = false;
+volatile uint32_t temperatureCycles = 0;
+
+void broadcastTemperature()
+{
+    if (events != NULL && events->count() > 0 && isTempValid(currentTemp))
+        events->send(String(currentTemp).c_str(), "temperature", hal.millis());
+}
+
+// Keeps the last valid temperature of probes that did not answer this time
+void takeProbeTemperatures()
+{
+    for (unsigned int i = 0; i < probeCount && i < temperatureCycle.probeCount; i++)
+    {
+        float temp = temperatureCycle.temps[i];
+        metrics.sensorReads++;
+
+        if (isTempValid(temp))
+        {
+            probes[i].temp = temp;
+            LOG_LINE(String("Current temperature '") + probes[i].name + String("': ") + String(temp) + String("°C"));
+        }
+        else
+        {
+            metrics.sensorInvalidReads++;
+            LOG_LINE(String("Could not read proper temperature of probe '") + probes[i].name + String("'!"));
+        }
+    }
+
+    if (probeCount > 0)
+        currentTemp = probes[0].temp;
+}
+
+void handleTemperatureConversion()
+{
+    TemperatureEvent event = stepTemperatureCycle(temperatureCycle, hal, samplingSettings.deadband, samplingSettings.lastReported, resolutionStats);
+    if (event == TEMPERATURE_EVENT_NONE)
+        return;
+
+    takeProbeTemperatures();
+
+    if (event == TEMPERATURE_EVENT_REPEAT)
+        LOG_LINE("Reading is close to the deadband threshold, converting again at full resolution");
+    else if (!temperatureCycle.allValid)
+        LOG_LINE(String("Could not read proper temperature on pin ") + String(DATA_PIN_THERMOMETER) + String("! Please check the wiring."));
+
+    if (event == TEMPERATURE_EVENT_FINISHED)
+    {
+        temperatureReadCompleted = true;
+        endPhase(PHASE_TEMPERATURE, temperatureCycle.cycleStart);
+        temperatureCycles++;
+
+        if (temperatureCycle.allValid)
+            broadcastTemperature();
+    }
+}
+
+void updateTemperature()
+{
+    if (temperatureCycle.state == TEMPERATURE_IDLE)
+        beginTemperatureCycle(temperatureCycle, hal, chooseResolution(samplingSettings.temperatureResolution, settingPassive, samplingSettings.deadband.active, events != NULL && events->count() > 0));
+}
+
+void updateBatteryStatus()
+{
+    if (samplingSettings.deadband.reportBattery)
+    {
+        unsigned long start = hal.millis();
+        uint32_t raw;
+        size_t sampleCount;
+        uint32_t batteryMillivolts = sampleBatteryMillivolts(hal, raw, sampleCount);
+
+        currentBatteryStatus = batteryLevelFrom(batteryMillivolts);
+        endPhase(PHASE_BATTERY, start);
+
+        LOG_LINE(String("Current battery level: ") + String(currentBatteryStatus * 100) + String("% (") + String(batteryMillivolts) + String(" mV) Raw: ") + String(raw) + String(" from ") + String(sampleCount) + String(" samples"));
+    }
+}
+
+const unsigned int UPDATE_INVERVAL_MS = 5000;
+unsigned long lastUpdated = 0;
+void updateValues()
+{
+    unsigned long now = hal.millis();
+    if (lastUpdated == 0 || lastUpdated + UPDATE_INVERVAL_MS < now || lastUpdated > now)
+    {
+        lastUpdated = hal.millis();
+
+        updateTemperature();
+        updateBatteryStatus();
+    }
+}
+
+unsigned long lastHistoryAdded = 0;
+void updateHistory()
+{
+    unsigned long now = hal.millis();
+    if (isTempValid(currentTemp) && (historyTotal == 0 || now - lastHistoryAdded >= HISTORY_INTERVAL_MS))
+    {
+        lastHistoryAdded = now;
+
+        Sample &sample = history[historyTotal % CAPACITY_HISTORY];
+        sample.time = hal.time();
+        sample.temp = currentTemp;
+        sample.batteryStatus = currentBatteryStatus;
+        historyTotal++;
+    }
+}
+
+bool parseHttpAddress(const String &address, String &host, uint16_t &port, String &uri)
+{
+    if (!address.startsWith("http://"))
+        return false;
+
+    int hostStart = strlen("http://");
+    int pathStart = address.indexOf('/', hostStart);
+    String hostPort = pathStart < 0 ? address.substring(hostStart) : address.substring(hostStart, pathStart);
+    uri = pathStart < 0 ? String("/") : address.substring(pathStart);
+
+    int portStart = hostPort.indexOf(':');
+    host = portStart < 0 ? hostPort : hostPort.substring(0, portStart);
+    port = portStart < 0 ? 80 : hostPort.substring(portStart + 1).toInt();
+
+    return host.length() > 0 && port > 0;
+}
+
+bool lookupDnsCache(const String &host, IPAddress &ip)
+{
+    for (unsigned int i = 0; i < MAX_REPORTING_HOSTS; i++)
+    {
+        if (host == dnsCache[i].host && hal.time() - dnsCache[i].resolvedAt < (time_t)MAX_SECS_DNS_CACHE)
+        {
+            ip = IPAddress(dnsCache[i].ip);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void storeDnsCache(const String &host, const IPAddress &ip)
+{
+    if (host.length() >= MAX_LENGTH_DNS_HOST)
+        return;
+
+    // Replacing the same host or otherwise the oldest entry
+    unsigned int slot = 0;
+    for (unsigned int i = 0; i < MAX_REPORTING_HOSTS; i++)
+    {
+        if (host == dnsCache[i].host)
+        {
+            slot = i;
+            break;
+        }
+        if (dnsCache[i].resolvedAt < dnsCache[slot].resolvedAt)
+            slot = i;
+    }
+
+    strcpy(dnsCache[slot].host, host.c_str());
+    dnsCache[slot].ip = (uint32_t)ip;
+    dnsCache[slot].resolvedAt = hal.time();
+}
+
+bool resolveHost(const String &host, IPAddress &ip)
+{
+    if (!WiFi.hostByName(host.c_str(), ip))
+        return false;
+
+    storeDnsCache(host, ip);
+    return true;
+}
+
+struct RequestResult
+{
+    volatile bool done;
+    volatile int status;
+};
+
+void completeRequest(void *arg, int status)
+{
+    RequestResult *result = (RequestResult *)arg;
+    result->status = status;
+    result->done = true;
+}
+
+// The request itself does not block, waiting for it only holds up the reporting and is bounded by the deadlines
+int awaitRequest(const char *method, const IPAddress &ip, uint16_t port, const String &host, const String &uri, const char *contentType, const char *body, size_t length)
+{
+    AsyncHttpTimeouts timeouts = {TIMEOUT_MS_REPORT_CONNECT, TIMEOUT_MS_REPORT_TOTAL};
+    RequestResult result = {false, 0};
+    if (!beginAsyncRequest(method, ip, port, host, uri, contentType, body, length, timeouts, completeRequest, &result))
+        return HTTPC_ERROR_CONNECTION_REFUSED;
+
+    while (!result.done)
+    {
+        serviceAsyncHttp();
+        hal.delay(1);
+    }
+
+    return result.status;
+}
+
+int requestAddress(const char *method, const String &address, const char *contentType, const char *body, size_t length)
+{
+    String host;
+    uint16_t port;
+    String uri;
+
+    // Only plain http is sent on AsyncTCP, everything else goes through HTTPClient with the same deadlines
+    if (!parseHttpAddress(address, host, port, uri))
+    {
+        HTTPClient client;
+        client.setConnectTimeout(TIMEOUT_MS_REPORT_CONNECT);
+        client.setTimeout(TIMEOUT_MS_REPORT_TOTAL);
+        client.begin(address);
+        client.addHeader("Content-Type", contentType);
+        return client.sendRequest(method, (uint8_t *)body, length);
+    }
+
+    IPAddress ip;
+    bool cached = lookupDnsCache(host, ip);
+    if (!cached && !resolveHost(host, ip))
+        return HTTPC_ERROR_CONNECTION_REFUSED;
+
+    int resCode = awaitRequest(method, ip, port, host, uri, contentType, body, length);
+
+    // A kept-alive connection may have been closed by the server meanwhile and a cached address may be outdated.
+    // Only the idempotent PUT is sent again on a lost connection, a POST may have been stored before and would be doubled.
+    if (resCode == HTTPC_ERROR_CONNECTION_LOST && strcmp(method, "PUT") == 0)
+        resCode = awaitRequest(method, ip, port, host, uri, contentType, body, length);
+    else if (resCode == HTTPC_ERROR_CONNECTION_REFUSED && cached && resolveHost(host, ip))
+        resCode = awaitRequest(method, ip, port, host, uri, contentType, body, length);
+
+    return resCode;
+}
+
+bool sendRequest(const char *method, const String &address, const char *contentType, const char *body, size_t length)
+{
+    unsigned long start = hal.millis();
+    int resCode = hal.sendRequest(method, address.c_str(), contentType, body, length);
+    observeHistogram(metrics.putDuration, PUT_DURATION_BOUNDS_MS, hal.millis() - start);
+    countStatusCode(resCode);
+
+    if (resCode <= 0)
+    {
+        LOG_LINE(
+            String("Could send ") + String(method) + String(" to address '") + address + String("'. The following error occured: '") +
+            String(resCode) +
+            String("' Please refer to the following address to get further information: ") +
+            String("https://github.com/esp8266/Arduino/blob/master/libraries/ESP8266HTTPClient/src/ESP8266HTTPClient.h"));
+    }
+    else if (resCode < 200 || resCode >= 300)
+    {
+        LOG_LINE(String("Server returned an error status code sending to '") + address + String("': '") + String(resCode) + String("'!"));
+    }
+    else
+    {
+        return true;
+    }
+
+    return false;
+}
+
+bool sendPutRequest(String address, String value)
+{
+    return sendRequest("PUT", address, "text/plain", value.c_str(), value.length());
+}
+
+bool mqttCallbacksRegistered = false;
+void setupMqtt()
+{
+    mqttClientId = String("Thermometer-") + settingSensorName;
+
+    // Callbacks are added to a list, so they are only registered once even if settings are applied again
+    if (!mqttCallbacksRegistered)
+    {
+        mqttClient.onConnect([](bool sessionPresent) { mqttConnected = true; });
+        mqttClient.onDisconnect([](AsyncMqttClientDisconnectReason reason) {
+            mqttConnected = false;
+            mqttPendingAcks = 0;
+        });
+        mqttClient.onPublish([](uint16_t packetId) {
+            if (mqttPendingAcks > 0)
+                mqttPendingAcks--;
+        });
+        mqttCallbacksRegistered = true;
+    }
+
+    mqttClient.setClientId(mqttClientId.c_str());
+    mqttClient.setCleanSession(settingMqttCleanSession);
+    mqttClient.setKeepAlive(constrain(settingIntervalSecs * 2, 60U, 65535U));
+    if (settingMqttUser.length() > 0)
+        mqttClient.setCredentials(settingMqttUser.c_str(), settingMqttPassword.c_str());
+    else
+        mqttClient.setCredentials(NULL, NULL);
+}
+
+bool connectMqtt()
+{
+    if (mqttConnected)
+        return true;
+
+    if (settingMqttHost.length() == 0)
+    {
+        LOG_LINE("Invalid setting for MQTT host found!");
+        return false;
+    }
+
+    // Using the DNS cache that is shared with HTTP reporting
+    IPAddress ip;
+    if (!lookupDnsCache(settingMqttHost, ip) && !resolveHost(settingMqttHost, ip))
+    {
+        LOG_LINE(String("Could not resolve MQTT host '") + settingMqttHost + String("'!"));
+        return false;
+    }
+
+    mqttClient.setServer(ip, settingMqttPort);
+    mqttClient.connect();
+
+    unsigned long start = hal.millis();
+    while (!mqttConnected && hal.millis() - start < TIMEOUT_MS_MQTT)
+    {
+        hal.delay(1);
+    }
+
+    if (!mqttConnected)
+        LOG_LINE(String("Could not connect to MQTT broker '") + settingMqttHost + String("'!"));
+
+    return mqttConnected;
+}
+
+bool publishMqtt(const String &topic, const String &value)
+{
+    if (topic.length() == 0)
+    {
+        LOG_LINE("Invalid setting for MQTT topic found!");
+        return false;
+    }
+
+    if (!connectMqtt())
+        return false;
+
+    // Retained, so subscribers get the last value of sleeping devices right away
+    uint8_t qos = min(settingMqttQos, 2U);
+    if (mqttClient.publish(topic.c_str(), qos, true, value.c_str()) == 0)
+    {
+        LOG_LINE(String("Could not publish to MQTT topic '") + topic + String("'!"));
+        return false;
+    }
+
+    if (qos > 0)
+        mqttPendingAcks++;
+
+    return true;
+}
+
+void finishMqtt()
+{
+    if (!mqttConnected)
+        return;
+
+    unsigned long start = hal.millis();
+    while (mqttPendingAcks > 0 && mqttConnected && hal.millis() - start < TIMEOUT_MS_MQTT)
+    {
+        hal.delay(1);
+    }
+
+    mqttClient.disconnect();
+    while (mqttConnected && hal.millis() - start < TIMEOUT_MS_MQTT)
+    {
+        hal.delay(1);
+    }
+}
+
+bool reportValue(const String &address, const String &topic, const String &value)
+{
+    if (settingReportingBackend == REPORTING_BACKEND_MQTT)
+        return publishMqtt(topic, value);
+    else
+        return sendPutRequest(address, value);
+}
+
+// The timings of this wake go out with its report, to an openHAB String item when reporting with HTTP PUT
+void reportDiagnostics()
+{
+    bool put = settingReportingBackend == REPORTING_BACKEND_HTTP && settingDiagnosticsAddress.length() > 0;
+    if (settingReportingBackend != REPORTING_BACKEND_MQTT && !put)
+        return;
+
+    DynamicJsonDocument doc(256 + PHASE_COUNT * 160);
+    doc["rssi"] = WiFi.RSSI();
+    doc["awakeMs"] = hal.millis() - millisStart;
+    doc["wifiMs"] = millisWifiDone - millisWifiStart;
+    doc["wifiCached"] = wifiFromCache;
+    doc["freeHeap"] = ESP.getFreeHeap();
+    doc["probes"] = probeCount;
+    doc["resolution"] = resolutionStats.lastResolution;
+    doc["conversionSavedMs"] = resolutionStats.lastSavedMs;
+    doc["queuedReports"] = reportQueue.count;
+    addPhaseTimings(doc.createNestedObject("timings"));
+
+    String json;
+    serializeJson(doc, json);
+    if (put)
+        sendPutRequest(settingDiagnosticsAddress, json);
+    else
+        publishMqtt(settingMqttTopicDiagnostics, json);
+}
+
+bool isBatchBackend()
+{
+    return settingReportingBackend == REPORTING_BACKEND_INFLUX || settingReportingBackend == REPORTING_BACKEND_JSON;
+}
+
+bool sendReport(uint8_t target, float value)
+{
+    String address;
+    String topic;
+    if (target == REPORT_TARGET_TEMPERATURE)
+    {
+        address = settingEditAddress;
+        topic = settingMqttTopicTemp;
+    }
+    else if (target == REPORT_TARGET_BATTERY)
+    {
+        address = settingReportBatteryAddress;
+        topic = settingMqttTopicBattery;
+    }
+    else if (target - REPORT_TARGET_PROBES < (int)probeCount)
+    {
+        address = probes[target - REPORT_TARGET_PROBES].reportAddress;
+        topic = settingMqttTopicTemp + String("/") + probes[target - REPORT_TARGET_PROBES].name;
+    }
+
+    // Queued reports of targets that were removed from the settings in the meantime have nowhere to go and are dropped,
+    // as are those left over after switching to a batch or multicast backend, which keep their backlog in the sample buffer
+    if (isBatchBackend() || settingReportingBackend == REPORTING_BACKEND_MULTICAST || (settingReportingBackend == REPORTING_BACKEND_MQTT ? topic.length() == 0 : address.length() == 0))
+        return true;
+
+    return reportValue(address, topic, String(value));
+}
+
+// Sends right away unless older reports are still waiting, then the value is queued behind them to keep the order
+bool deliverReport(uint8_t target, float value)
+{
+    if (reportQueue.count == 0)
+    {
+        if (sendReport(target, value))
+            return true;
+
+        registerReportFailure(reportQueue, hal.time(), hal.random());
+        LOG_LINE(String("Report failed, retrying in ") + String((long)(reportQueue.nextRetry - hal.time())) + String(" seconds"));
+    }
+
+    if (!enqueueReport(reportQueue, target, value, hal.time()))
+        LOG_LINE("Report queue full, dropped the oldest report!");
+
+    return false;
+}
+
+// Delivers queued reports oldest first until one fails or the radio time budget of this cycle is used up
+void drainReportQueue()
+{
+    if (!isRetryDue(reportQueue, hal.time()))
+        return;
+
+    unsigned int stale = dropStaleReports(reportQueue, hal.time());
+    if (stale > 0)
+        LOG_LINE(String("Dropped ") + String(stale) + String(" queued reports that were too old"));
+
+    LOG_LINE(String("Retrying ") + String(reportQueue.count) + String(" queued reports..."));
+
+    unsigned long start = hal.millis();
+    const QueuedReport *report;
+    while ((report = peekReport(reportQueue)) != NULL && hal.millis() - start < MAX_MS_REPORT_QUEUE_DRAIN)
+    {
+        if (!sendReport(report->target, report->value))
+        {
+            registerReportFailure(reportQueue, hal.time(), hal.random());
+            LOG_LINE(String("Retry failed, ") + String(reportQueue.count) + String(" reports queued, next retry in ") + String((long)(reportQueue.nextRetry - hal.time())) + String(" seconds"));
+            return;
+        }
+
+        popReport(reportQueue);
+    }
+
+    registerReportSuccess(reportQueue);
+    LOG_LINE(String("Queued reports delivered, ") + String(reportQueue.count) + String(" left for the next cycle"));
+}
+
+bool runThermometerReporting(float temp)
+{
+    bool successful = false;
+
+    if (settingReportingBackend == REPORTING_BACKEND_HTTP && settingEditAddress.length() == 0)
+    {
+        LOG_LINE("Invalid setting for address thermometer found!");
+    }
+    else if (!isTempValid(temp))
+    {
+        LOG_LINE("Invalid temperature found! Cannot finish reporting successfully!");
+    }
+    else
+    {
+        unsigned long start = hal.millis();
+        successful = deliverReport(REPORT_TARGET_TEMPERATURE, temp);
+        endPhase(PHASE_PUT_TEMPERATURE, start);
+        LOG_LINE(String("Reporting temperature finished!"));
+    }
+
+    return successful;
+}
+
+bool runBatteryReporting(float batteryStatus)
+{
+    bool successful = false;
+
+    if (settingReportBattery)
+    {
+        if (settingReportingBackend == REPORTING_BACKEND_HTTP && settingReportBatteryAddress.length() == 0)
+        {
+            LOG_LINE("Invalid setting for address battery found!");
+        }
+        else if (batteryStatus < 0.0F)
+        {
+            LOG_LINE(String("Invalid battery status found! Cannot finish reporting successfully!"));
+        }
+        else
+        {
+            unsigned long start = hal.millis();
+            successful = deliverReport(REPORT_TARGET_BATTERY, batteryStatus);
+            endPhase(PHASE_PUT_BATTERY, start);
+            LOG_LINE(String("Reporting battery finished!"));
+        }
+    }
+
+    return successful;
+}
+
+void runProbesReporting(const Reading &reading)
+{
+    // The first probe is reported to the temperature address or topic above
+    for (unsigned int i = 1; i < probeCount && i < reading.probeCount; i++)
+    {
+        bool configured = settingReportingBackend == REPORTING_BACKEND_MQTT || probes[i].reportAddress[0] != '\0';
+        if (configured && isTempValid(reading.probeTemps[i]))
+        {
+            deliverReport(REPORT_TARGET_PROBES + i, reading.probeTemps[i]);
+            LOG_LINE(String("Reporting probe '") + probes[i].name + String("' finished!"));
+        }
+    }
+}
+
+// Values of the sampling side, only called from the task that samples
+Reading currentReading()
+{
+    Reading reading;
+    reading.temp = currentTemp;
+    reading.batteryStatus = currentBatteryStatus;
+    reading.probeCount = probeCount;
+    for (unsigned int i = 0; i < MAX_READING_PROBES; i++)
+        reading.probeTemps[i] = i < probeCount ? probes[i].temp : -127.0F;
+
+    return reading;
+}
+
+bool isReportDue(const Reading &reading)
+{
+    return isReportDue(deadbandSettings(), lastReported, hal.time(), isTempValid(reading.temp), reading.temp, reading.batteryStatus);
+}
 
-AsyncWebServer *webServer = NULL;
-OneWire oneWire(DATA_PIN_THERMOMETER);
-DallasTemperature sensors(&oneWire);
+bool readingLogStarted = false;
+void logReading(const Sample &sample)
+{
+    if (settingLogReadings && readingLogStarted && !appendReadingLog(hal, sample))
+        LOG_LINE("Could not append reading to log!");
+}
 
-float currentTemp = -127.0F;
-float currentBatteryStatus = -1.0F;
+// Sends one buffered sample right away, reports that have nowhere to go count as sent like in sendReport()
+bool sendSample(const Sample &sample)
+{
+    if (isTempValid(sample.temp) && !sendReport(REPORT_TARGET_TEMPERATURE, sample.temp))
+        return false;
 
-String settingSensorName;
-bool settingActivateReporting;
-String settingBaseAddress;
-unsigned int settingIntervalSecs;
-bool settingPassive;
-bool settingReportBattery;
-String settingReportBatteryAddressSuffix;
+    return !settingReportBattery || sample.batteryStatus < 0.0F || sendReport(REPORT_TARGET_BATTERY, sample.batteryStatus);
+}
 
-unsigned long millisStart;
+// Buffered samples bypass the report queue, which holds far fewer of them. Like a failed batch upload, the first
+// sample that fails stays in the sample buffer with all after it and the next cycle continues from there.
+void flushSampleBuffer()
+{
+    // Older reports go out first to keep the order
+    if (reportQueue.count > 0)
+    {
+        LOG_LINE(String("Reports are still queued, keeping ") + String(sampleBuffer.samples.count) + String(" buffered samples"));
+        return;
+    }
 
-String getShortMac()
+    LOG_LINE(String("Uploading ") + String(sampleBuffer.samples.count) + String(" buffered samples..."));
+
+    unsigned long start = hal.millis();
+    EncodedSamples unsent;
+    clearSamples(unsent);
+
+    SampleReader reader;
+    Sample sample;
+    beginDecoding(reader, sampleBuffer.samples);
+    while (decodeSample(reader, sample))
+    {
+        if (unsent.count == 0 && sendSample(sample))
+            logReading(sample);
+        else
+            encodeSample(unsent, sample);
+    }
+
+    endPhase(PHASE_PUT_TEMPERATURE, start);
+
+    sampleBuffer.samples = unsent;
+    if (unsent.count > 0)
+    {
+        LOG_LINE(String("Upload of buffered samples failed, keeping ") + String(unsent.count) + String(" samples for the next one"));
+        return;
+    }
+
+    sampleBuffer.lastFlush = hal.time();
+    LOG_LINE(String("Buffered samples uploaded!"));
+}
+
+// Batches and datagrams carry timestamps, the clock is set once after a cold boot and kept by the RTC through deep sleep
+void syncClock()
 {
-    uint8_t mac[6];
-    esp_read_mac(mac, ESP_MAC_WIFI_STA);
+    if (hal.time() >= MIN_VALID_BATCH_TIME)
+        return;
 
-    String macStringLastPart = "";
-    for (int i = 4; i < 6; i++)
+    configTime(0, 0, NTP_SERVER);
+    unsigned long start = hal.millis();
+    while (hal.time() < MIN_VALID_BATCH_TIME && hal.millis() - start < TIMEOUT_MS_CLOCK_SYNC)
     {
-        macStringLastPart += String(mac[i], HEX);
+        hal.delay(10);
     }
 
-    return macStringLastPart;
+    if (hal.time() < MIN_VALID_BATCH_TIME)
+        LOG_LINE("Could not set the clock, readings are sent without timestamps!");
 }
 
-void initiateDeepSleepForReporting()
+// Times of a clock that was never set are sent as 0, so receivers use their own
+time_t validTime(time_t time)
 {
-    esp_sleep_enable_timer_wakeup(settingIntervalSecs * 1000 * 1000);
-    esp_deep_sleep_start();
+    return time >= MIN_VALID_BATCH_TIME ? time : 0;
 }
 
-bool isTempValid(float temp)
+bool postBatch(BatchWriter &writer)
 {
-    return (temp > -30.0F && temp < 60.0F);
+    size_t length = finishBatch(writer);
+    return length > 0 && sendRequest("POST", settingBatchAddress, batchContentType(writer.format), batchBuffer, length);
 }
 
-void readSettings()
+// Counts backlog samples, the current values count as the one after the last buffered sample
+struct BatchProgress
 {
-    Preferences prefs;
-    prefs.begin(PREFS_NAME, true);
+    // Written into a batch so far, also those that were skipped
+    uint16_t batched;
+    // In batches the server accepted
+    uint16_t acknowledged;
+};
 
-    settingSensorName = prefs.getString(ID_NAME, getShortMac());
-    settingActivateReporting = prefs.getBool(ID_ACTIVATE_REPORTING, false);
-    settingEditAddress = prefs.getString(ID_EDIT_ADDRESS, "");
-    settingIntervalSecs = prefs.getUInt(ID_INTERVAL_SECS, 1800);
-    settingPassive = prefs.getBool(ID_PASSIVE, false);
-    settingReportBattery = prefs.getBool(ID_REPORT_BATTERY, false);
-    settingReportBatteryAddress = prefs.getString(ID_REPORT_BATTERY_ADDRESS, "");
+bool postBatch(BatchWriter &writer, BatchProgress &progress)
+{
+    if (!postBatch(writer))
+        return false;
 
-    prefs.end();
+    progress.acknowledged = progress.batched;
+    return true;
 }
 
-void saveSettings()
+// A full batch is sent and the entry goes into a new one, so a large backlog takes several POSTs
+bool addToBatch(BatchWriter &writer, BatchProgress &progress, const char *probe, time_t time, float temp, float batteryStatus)
 {
-    Preferences prefs;
-    prefs.begin(PREFS_NAME, false);
+    if (addBatchSample(writer, probe, time, temp, batteryStatus))
+        return true;
 
-    prefs.putString(ID_NAME, settingSensorName);
-    prefs.putBool(ID_ACTIVATE_REPORTING, settingActivateReporting);
-    prefs.putString(ID_EDIT_ADDRESS, settingEditAddress);
-    prefs.putUInt(ID_INTERVAL_SECS, settingIntervalSecs);
-    prefs.putBool(ID_PASSIVE, settingPassive);
-    prefs.putBool(ID_REPORT_BATTERY, settingReportBattery);
-    prefs.putString(ID_REPORT_BATTERY_ADDRESS, settingReportBatteryAddress);
+    if (!postBatch(writer, progress))
+        return false;
 
-    prefs.end();
+    beginBatch(writer, writer.format, batchBuffer, sizeof(batchBuffer), writer.sensor);
+    return addBatchSample(writer, probe, time, temp, batteryStatus);
 }
 
-void resetSettings()
+void logSampleBuffer()
 {
-    Preferences prefs;
-    prefs.begin(PREFS_NAME, false);
-    prefs.clear();
-    prefs.end();
+    SampleReader reader;
+    Sample sample;
+    beginDecoding(reader, sampleBuffer.samples);
+    while (decodeSample(reader, sample))
+    {
+        logReading(sample);
+    }
 }
 
-
-void handleRootPage(AsyncWebServerRequest *request)
+// Logs the samples the server accepted and keeps the rest for the next upload
+void dropAcknowledgedSamples(uint16_t acknowledged)
 {
-    request->send_P(200, "text/html", rootPage);
+    EncodedSamples unsent;
+    clearSamples(unsent);
+
+    SampleReader reader;
+    Sample sample;
+    beginDecoding(reader, sampleBuffer.samples);
+    while (decodeSample(reader, sample))
+    {
+        if (reader.index <= acknowledged)
+            logReading(sample);
+        else
+            encodeSample(unsent, sample);
+    }
+
+    sampleBuffer.samples = unsent;
 }
 
-void handleSettingsPage(AsyncWebServerRequest *request)
+// Sends the buffered backlog and the current values in one POST, or several for a large backlog. If one fails,
+// the samples of the batches that went out before are dropped and the rest stays in the sample buffer.
+bool runBatchReporting(const Reading &reading)
 {
-    request->send_P(200, "text/html", settingsPage);
+    if (settingBatchAddress.length() == 0)
+    {
+        LOG_LINE("Invalid setting for batch address found!");
+        return false;
+    }
+
+    unsigned long start = hal.millis();
+    syncClock();
+
+    time_t now = hal.time();
+    BatchWriter writer;
+    BatchFormat format = settingReportingBackend == REPORTING_BACKEND_INFLUX ? BATCH_FORMAT_INFLUX : BATCH_FORMAT_JSON;
+    beginBatch(writer, format, batchBuffer, sizeof(batchBuffer), settingSensorName.c_str());
+
+    bool successful = true;
+    BatchProgress progress = {0, 0};
+    SampleReader reader;
+    Sample sample;
+    beginDecoding(reader, sampleBuffer.samples);
+    while (successful && decodeSample(reader, sample))
+    {
+        if (isTempValid(sample.temp))
+            successful = addToBatch(writer, progress, NULL, sample.time, sample.temp, settingReportBattery ? sample.batteryStatus : -1.0F);
+        if (successful)
+            progress.batched = reader.index;
+    }
+
+    // When sampling in batches the current values were buffered on this wake already
+    Sample current;
+    current.time = now;
+    current.temp = reading.temp;
+    current.batteryStatus = reading.batteryStatus;
+    bool addCurrent = !isBatchSampling() && isTempValid(reading.temp);
+    if (successful && addCurrent)
+        successful = addToBatch(writer, progress, NULL, now, reading.temp, settingReportBattery ? reading.batteryStatus : -1.0F);
+    if (successful)
+        progress.batched = sampleBuffer.samples.count + 1;
+
+    for (unsigned int i = 1; successful && i < probeCount && i < reading.probeCount; i++)
+    {
+        if (isTempValid(reading.probeTemps[i]))
+            successful = addToBatch(writer, progress, probes[i].name, now, reading.probeTemps[i], -1.0F);
+    }
+
+    int32_t rssi = WiFi.RSSI();
+    uint32_t awakeMs = hal.millis() - millisStart;
+    if (successful && !addBatchStatus(writer, now, rssi, awakeMs))
+    {
+        successful = postBatch(writer, progress);
+        beginBatch(writer, format, batchBuffer, sizeof(batchBuffer), writer.sensor);
+        addBatchStatus(writer, now, rssi, awakeMs);
+    }
+
+    if (successful)
+        successful = postBatch(writer, progress);
+
+    endPhase(PHASE_PUT_TEMPERATURE, start);
+
+    if (!successful)
+    {
+        bool currentAcknowledged = progress.acknowledged > sampleBuffer.samples.count;
+        dropAcknowledgedSamples(progress.acknowledged);
+        if (addCurrent && currentAcknowledged)
+            logReading(current);
+        else if (addCurrent)
+            encodeSample(sampleBuffer.samples, current);
+        LOG_LINE(String("Batch upload failed, keeping ") + String(sampleBuffer.samples.count) + String(" samples for the next one"));
+        return false;
+    }
+
+    // Samples are logged once they were delivered, failed ones are still in the buffer until then
+    logSampleBuffer();
+    if (addCurrent)
+        logReading(current);
+
+    clearSamples(sampleBuffer.samples);
+    sampleBuffer.lastFlush = now;
+
+    if (isTempValid(reading.temp))
+    {
+        lastReported.tempValid = true;
+        lastReported.temp = reading.temp;
+        lastReported.time = now;
+    }
+
+    if (settingReportBattery && reading.batteryStatus >= 0.0F)
+    {
+        lastReported.batteryStatusValid = true;
+        lastReported.batteryStatus = reading.batteryStatus;
+    }
+
+    LOG_LINE(String("Batch upload finished!"));
+    return true;
 }
 
-void handleGetTemperature(AsyncWebServerRequest *request)
+bool sendDatagram(ReadingDatagram &datagram)
 {
-    if (isTempValid(currentTemp))
-        request->send(200, "text/plain", String(currentTemp));
-    else
-        request->send(500, "text/plain", "Temperature could not be determined!");
+    IPAddress group;
+    if (!group.fromString(settingMulticastGroup))
+    {
+        LOG_LINE("Invalid setting for multicast group found!");
+        return false;
+    }
+
+    datagram.sequence = datagramSequence++;
+    strlcpy(datagram.name, settingSensorName.c_str(), sizeof(datagram.name));
+    datagram.rssi = WiFi.RSSI();
+
+    uint8_t data[MAX_SIZE_READING_DATAGRAM];
+    size_t length = encodeReadingDatagram(datagram, data, sizeof(data));
+    return length > 0 && udp.writeTo(data, length, group, settingMulticastPort) == length;
 }
 
-void handleGetSettings(AsyncWebServerRequest *request)
+// Datagrams are not acknowledged, so the backlog is sent once and cleared whether anyone received it or not
+void runMulticastReporting(const Reading &reading)
 {
-    DynamicJsonDocument doc(1024);
+    unsigned long start = hal.millis();
+    syncClock();
+    ReadingDatagram datagram;
 
-    doc[ID_NAME] = settingName;
-    doc[ID_ACTIVATE_REPORTING] = settingActivateReporting;
-    doc[ID_EDIT_ADDRESS] = settingEditAddress;
-    doc[ID_INTERVAL_SECS] = settingIntervalSecs;
-    doc[ID_PASSIVE] = settingPassive;
-    doc[ID_REPORT_BATTERY] = settingReportBattery;
-    doc[ID_REPORT_BATTERY_ADDRESS] = settingReportBatteryAddress;
+    SampleReader reader;
+    Sample sample;
+    beginDecoding(reader, sampleBuffer.samples);
+    while (decodeSample(reader, sample))
+    {
+        logReading(sample);
 
-    String json;
-    serializeJson(doc, json);
+        datagram.time = validTime(sample.time);
+        datagram.tempValid = isTempValid(sample.temp);
+        datagram.temp = sample.temp;
+        datagram.batteryValid = settingReportBattery && sample.batteryStatus >= 0.0F;
+        datagram.batteryStatus = sample.batteryStatus;
+        datagram.probeCount = 0;
+        sendDatagram(datagram);
+    }
 
-    request->send(200, "application/json", json);
+    clearSamples(sampleBuffer.samples);
+    sampleBuffer.lastFlush = hal.time();
+
+    // When sampling in batches the current values were in the buffer above already
+    if (!isBatchSampling())
+    {
+        Sample current;
+        current.time = hal.time();
+        current.temp = reading.temp;
+        current.batteryStatus = reading.batteryStatus;
+        logReading(current);
+
+        datagram.time = validTime(current.time);
+        datagram.tempValid = isTempValid(reading.temp);
+        datagram.temp = reading.temp;
+        datagram.batteryValid = settingReportBattery && reading.batteryStatus >= 0.0F;
+        datagram.batteryStatus = reading.batteryStatus;
+
+        // The first probe is the temperature above
+        datagram.probeCount = 0;
+        for (unsigned int i = 1; i < probeCount && i < reading.probeCount && datagram.probeCount < MAX_DATAGRAM_PROBES; i++)
+        {
+            datagram.probeValid[datagram.probeCount] = isTempValid(reading.probeTemps[i]);
+            datagram.probeTemps[datagram.probeCount] = reading.probeTemps[i];
+            datagram.probeCount++;
+        }
+
+        if (!sendDatagram(datagram))
+            LOG_LINE("Could not send datagram!");
+    }
+
+    if (isTempValid(reading.temp))
+    {
+        lastReported.tempValid = true;
+        lastReported.temp = reading.temp;
+        lastReported.time = hal.time();
+    }
+
+    if (settingReportBattery && reading.batteryStatus >= 0.0F)
+    {
+        lastReported.batteryStatusValid = true;
+        lastReported.batteryStatus = reading.batteryStatus;
+    }
+
+    // Sending only hands the datagram to the WiFi driver, deep sleep right after could still drop it
+    if (settingPassive)
+        hal.delay(DELAY_MS_DATAGRAM_SENT);
+
+    endPhase(PHASE_PUT_TEMPERATURE, start);
+    LOG_LINE(String("Multicast reporting finished!"));
 }
 
-void handlePostSettings(AsyncWebServerRequest *request, uint8_t *data, size_t len, size_t index, size_t total)
+void runReporting(const Reading &reading)
 {
-    if (len != total)
+    unsigned long millisReportingStart = hal.millis();
+
+    drainReportQueue();
+
+    if (isBatchBackend())
+    {
+        runBatchReporting(reading);
+    }
+    else if (settingReportingBackend == REPORTING_BACKEND_MULTICAST)
+    {
+        runMulticastReporting(reading);
+    }
+    else if (sampleBuffer.samples.count > 0)
     {
-        request->send(400, "text/plain", "No settings found!");
+        // Goes behind the backlog, when sampling in batches it was buffered on this wake already
+        if (!isBatchSampling())
+        {
+            Sample current;
+            current.time = hal.time();
+            current.temp = reading.temp;
+            current.batteryStatus = reading.batteryStatus;
+            encodeSample(sampleBuffer.samples, current);
+        }
+
+        flushSampleBuffer();
     }
     else
     {
-        DynamicJsonDocument doc(len);
-        if (deserializeJson(doc, data) != DeserializationError::Ok)
-        {
-            request->send(400, "text/plain", "Could not parse JSON!");
-        }
-        else if (!doc.containsKey(ID_NAME))
-            request->send(400, "text/plain", String(ID_NAME) + String(" missing!"));
-        else if (!doc.containsKey(ID_ACTIVATE_REPORTING))
-            request->send(400, "text/plain", String(ID_ACTIVATE_REPORTING) + String(" missing!"));
-        else if (!doc.containsKey(ID_EDIT_ADDRESS))
-            request->send(400, "text/plain", String(ID_EDIT_ADDRESS) + String(" missing!"));
-        else if (!doc.containsKey(ID_INTERVAL_SECS))
-            request->send(400, "text/plain", String(ID_INTERVAL_SECS) + String(" missing!"));
-        else if (!doc.containsKey(ID_PASSIVE))
-            request->send(400, "text/plain", String(ID_PASSIVE) + String(" missing!"));
-        else if (!doc.containsKey(ID_REPORT_BATTERY))
-            request->send(400, "text/plain", String(ID_REPORT_BATTERY) + String(" missing!"));
-        else if (!doc.containsKey(ID_REPORT_BATTERY_ADDRESS))
-            request->send(400, "text/plain", String(ID_REPORT_BATTERY_ADDRESS) + String(" missing!"));
+        Sample sample;
+        sample.time = hal.time();
+        sample.temp = reading.temp;
+        sample.batteryStatus = reading.batteryStatus;
+        logReading(sample);
 
-        else
+        if (runThermometerReporting(reading.temp))
         {
-            settingName = doc[ID_NAME].as<String>();
-            settingActivateReporting = doc[ID_ACTIVATE_REPORTING];
-            settingEditAddress = doc[ID_EDIT_ADDRESS].as<String>();
-            settingIntervalSecs = doc[ID_INTERVAL_SECS];
-            settingPassive = doc[ID_PASSIVE];
-            settingReportBattery = doc[ID_REPORT_BATTERY];
-            settingReportBatteryAddress = doc[ID_REPORT_BATTERY_ADDRESS].as<String>();
+            lastReported.tempValid = true;
+            lastReported.temp = reading.temp;
+            lastReported.time = hal.time();
+        }
 
-            saveSettings();
+        if (runBatteryReporting(reading.batteryStatus))
+        {
+            lastReported.batteryStatusValid = true;
+            lastReported.batteryStatus = reading.batteryStatus;
         }
 
-        request->send(200, "text/plain", "OK!");
+        runProbesReporting(reading);
+    }
+
+    reportDiagnostics();
 
-        delay(300);
+    if (settingPassive)
+    {
+        finishMqtt();
 
-        ESP.restart();
+        unsigned long now = hal.millis();
+        long timeAwake = now - millisStart;
+        LOG_LINE(String("Passive mode active and thus going to deep sleep. Time awake: ") + String(timeAwake) + String(" milliseconds"));
+        LOG_LINE(
+            String("Boot: ") + String(millisWifiStart - millisStart) +
+            String(" ms, WiFi (") + String(wifiFromCache ? "cached" : "full") + String("): ") + String(millisWifiDone - millisWifiStart) +
+            String(" ms, Sampling: ") + String(millisReportingStart - millisWifiDone) +
+            String(" ms, Reporting: ") + String(now - millisReportingStart) + String(" ms"));
+        initiateDeepSleepForReporting();
     }
+
+    LOG_LINE(String("Reporting finished! Next update in '") + String(settingIntervalSecs) + String("' seconds!"));
 }
 
-void setupWebServer()
+void bufferSample()
 {
-    webServer = new AsyncWebServer(80);
+    Sample sample;
+    sample.time = hal.time();
+    sample.temp = currentTemp;
+    sample.batteryStatus = currentBatteryStatus;
 
-    webServer->onNotFound([](AsyncWebServerRequest *request) { request->send(404, "text/plain", "Not found!"); });
-    webServer->on("/", HTTP_GET, [&](AsyncWebServerRequest *request) { handleRootPage(request); });
-    webServer->on("/settingsPage", HTTP_GET, [&](AsyncWebServerRequest *request) { handleSettingsPage(request); });
-    webServer->on("/settings", HTTP_GET, [&](AsyncWebServerRequest *request) { handleGetSettings(request); });
-    webServer->on("/settings", HTTP_POST,
-                  [](AsyncWebServerRequest *request) -> void { request->send(400, "text/plain", "No data!"); },
-                  [](AsyncWebServerRequest *request, const String &filename, size_t index, uint8_t *data, size_t len, bool final) -> void { request->send(400, "text/plain", "Wrong data!"); },
-                  [&](AsyncWebServerRequest *request, uint8_t *data, size_t len, size_t index, size_t total) -> void { handlePostSettings(request, data, len, index, total); });
-    webServer->on("/temperature", HTTP_GET, [&](AsyncWebServerRequest *request) { handleGetTemperature(request); });
+    // Drops the oldest samples if uploads kept failing
+    encodeSample(sampleBuffer.samples, sample);
+}
 
-    webServer->begin();
+bool isUploadDue()
+{
+    BatchSettings batch;
+    batch.batchSize = settingBatchSize;
+    batch.intervalSecs = settingIntervalSecs;
+    batch.marginSamples = MARGIN_SAMPLE_BUFFER_FULL;
+
+    return isUploadDue(batch, sampleBuffer.samples, sampleBuffer.lastFlush, hal.time());
 }
 
-void updateTemperature()
+// When sampling in batches a wake that got this far has an upload due, which the deadband must not hold back
+bool isReportingDue(const Reading &reading)
 {
-    int tries = 0;
-    bool successful = false;
-    while (tries < 5 && !successful)
+    return isBatchSampling() ? isUploadDue() : isReportDue(reading);
+}
+
+unsigned long lastReportingChecked = 0;
+void handleReporting(const Reading &reading)
+{
+    // Waiting for the first conversion so reporting never sends the initial placeholder value
+    if (!temperatureReadCompleted)
+        return;
+
+    // Passive wakes always end in deep sleep, runReporting() sleeps after reporting and everything else sleeps here
+    if (!settingActivateReporting)
+    {
+        if (settingPassive)
+            initiateDeepSleepForReporting();
+        return;
+    }
+
+    unsigned long now = hal.millis();
+    if (lastReportingChecked == 0 || lastReportingChecked + settingIntervalSecs * 1000 < now || lastReportingChecked > now)
     {
-        sensors.requestTemperatures();
-        float temp = sensors.getTempCByIndex(0);
+        lastReportingChecked = hal.millis();
 
-        if (!isTempValid(temp))
+        if (isReportingDue(reading))
         {
-            Serial.println(String("Could not read proper temperature on pin ") + String(DATA_PIN_THERMOMETER) + String("! Please check the wiring."));
-            delay(100);
+            LOG_LINE("Reporting executing...");
+            runReporting(reading);
+            publishSamplingSettings();
         }
         else
         {
-            currentTemp = temp;
-            Serial.println(String("Current temperature: ") + String(currentTemp) + String("°C"));
-            successful = true;
+            LOG_LINE("Values within deadband, skipping report!");
+            if (settingPassive)
+                initiateDeepSleepForReporting();
         }
-        tries++;
     }
 }
 
-void updateBatteryStatus()
+bool sensorsSetUp = false;
+void setupSensors()
 {
-    if (settingReportBattery)
+    if (!sensorsSetUp)
     {
-        int sumValues = 0;
-        for (int i = 0; i < NUMBER_SAMPLES_BATTERY; i++)
-        {
-            sumValues += analogRead(PIN_BATTERY_MONITORING);
-        }
+        unsigned long start = hal.millis();
+        LOG_LINE("Setting up sensors");
+        sensors.begin();
+        sensors.setWaitForConversion(false);
+        // The resolution changes from wake to wake, writing it to the EEPROM of the probes every time would wear it out
+        sensors.setAutoSaveScratchPad(false);
 
-        float value = (float)sumValues / (float)NUMBER_SAMPLES_BATTERY;
-        float batteryVoltage = ((float)value / 2047.0F) * 4.2F;
+        // Enumerating again on cold boots if probes were added or removed, timer wakes trust the cache
+        readProbes();
+        if (probeCount == 0 || (esp_sleep_get_wakeup_cause() != ESP_SLEEP_WAKEUP_TIMER && sensors.getDeviceCount() != probeCount))
+            findProbes();
+
+        sensorsSetUp = true;
+        endPhase(PHASE_SENSORS, start);
+        LOG_LINE("Sensors set up!");
+    }
+}
 
-        currentBatteryStatus = (batteryVoltage - (2.8F)) / (4.2F - 2.8F);
+void readValues()
+{
+    takeSamplingSettings();
+    setupSensors();
 
-        Serial.println(String("Current battery level: ") + String(currentBatteryStatus * 100) + String("% (") + String(batteryVoltage) + String(" V) Raw: ") + String(value));
-        Serial.println(value);
+    updateTemperature();
+    while (!temperatureReadCompleted)
+    {
+        handleTemperatureConversion();
+        hal.delay(1);
     }
+    updateBatteryStatus();
+
+    // These values are current, so loop() does not convert again right away
+    lastUpdated = hal.millis();
 }
 
-const unsigned int UPDATE_INVERVAL_MS = 5000;
-unsigned long lastUpdated = 0;
-void updateValues()
+// Returns whether any probe was changed, so unchanged probes are not written to flash again
+bool applyProbeEdits(const ProbeEdit *edits, unsigned int count)
 {
-    unsigned long now = millis();
-    if (lastUpdated == 0 || lastUpdated + UPDATE_INVERVAL_MS < now || lastUpdated > now)
+    bool changed = false;
+    for (unsigned int e = 0; e < count; e++)
     {
-        lastUpdated = millis();
+        for (unsigned int i = 0; i < probeCount; i++)
+        {
+            if (romToString(probes[i].rom) != edits[e].rom)
+                continue;
 
-        updateTemperature();
-        updateBatteryStatus();
+            if (strcmp(probes[i].name, edits[e].name) != 0 || strcmp(probes[i].reportAddress, edits[e].reportAddress) != 0)
+            {
+                strlcpy(probes[i].name, edits[e].name, sizeof(probes[i].name));
+                strlcpy(probes[i].reportAddress, edits[e].reportAddress, sizeof(probes[i].reportAddress));
+                changed = true;
+            }
+        }
     }
+
+    return changed;
 }
 
-void sendPutRequest(String address, String value)
+void takeChangedSettings()
 {
-    HTTPClient client;
-    client.begin(address);
-    client.addHeader("Content-Type", "text/plain");
+    SettingsRecord record;
+    ProbeEdit edits[MAX_PROBES];
+    unsigned int editCount;
 
-    int resCode = client.PUT(value);
+    portENTER_CRITICAL(&settingsMux);
+    record = pendingSettings;
+    editCount = pendingProbeEditCount;
+    memcpy(edits, pendingProbeEdits, editCount * sizeof(ProbeEdit));
+    settingsChanged = false;
+    portEXIT_CRITICAL(&settingsMux);
 
-    if (resCode <= 0)
+    if (applyProbeEdits(edits, editCount))
+        saveProbes();
+
+    // A new host name or boot mode takes effect with the restart, until then the running ones stay
+    if (strcmp(record.name, settingSensorName.c_str()) != 0 || record.passive != settingPassive)
     {
-        Serial.println(
-            String("Could send PUT to address '") + address + String("'. The following error occured: '") +
-            String(resCode) +
-            String("' Please refer to the following address to get further information: ") +
-            String("https://github.com/esp8266/Arduino/blob/master/libraries/ESP8266HTTPClient/src/ESP8266HTTPClient.h"));
+        storeSettingsRecord(record);
+        return;
     }
-    else if (resCode < 200 || resCode >= 300)
+
+    LOG_LINE("Applying changed settings...");
+    String previousMqtt = mqttSignature();
+    applySettingsRecord(record);
+    storeSettingsRecord(record);
+    publishSamplingSettings();
+
+    if (settingLogReadings && !readingLogStarted)
+        readingLogStarted = beginReadingLog(hal);
+
+    // The MQTT client keeps pointers to the old settings, so it is set up again before the next connect
+    if (mqttSignature() != previousMqtt)
     {
-        Serial.println(String("Server returned an error status code sending to '") + address + String("': '") + String(resCode) + String("'!"));
+        mqttClient.disconnect(true);
+        mqttConnected = false;
+        if (settingReportingBackend == REPORTING_BACKEND_MQTT)
+            setupMqtt();
     }
+
+    // Reporting with the new settings right away
+    lastReportingChecked = 0;
 }
 
-void runThermometerReporting()
+// Only called from the task that owns the settings, the web server just leaves them in pendingSettings
+void applyChangedSettings()
 {
-    if (settingEditAddress.length() == 0)
-    {
-        Serial.println("Invalid setting for address thermometer found!");
-    }
-    else if (!isTempValid(currentTemp))
-    {
-        Serial.println("Invalid temperature found! Cannot finish reporting successfully!");
-    }
-    else
-    {
-        sendPutRequest(settingEditAddress, String(currentTemp));
-        Serial.println(String("Reporting temperature finished!"));
-    }
+    if (settingsChanged)
+        takeChangedSettings();
+
+    // Checked after the settings were stored, so a restart never loses them
+    if (restartRequestedAt != 0 && hal.millis() - restartRequestedAt >= DELAY_MS_RESTART)
+        ESP.restart();
 }
 
-void runBatteryReporting()
+QueueHandle_t readingQueue = NULL;
+
+// Samples on its own core, so neither a slow reporting server nor the web server delays the readings
+void samplingTask(void *parameter)
 {
-    if (settingReportBattery)
+    uint32_t publishedCycles = temperatureCycles;
+    for (;;)
     {
-        if (settingReportBatteryAddress.length() == 0)
-        {
-            Serial.println("Invalid setting for address battery found!");
-        }
-        else if (currentBatteryStatus < 0.0F)
-        {
-            Serial.println(String("Invalid battery status found! Cannot finish reporting successfully!"));
-        }
-        else
+        unsigned long start = hal.millis();
+
+        takeSamplingSettings();
+        updateValues();
+        handleTemperatureConversion();
+
+        if (temperatureCycles != publishedCycles)
         {
-            sendPutRequest(settingReportBatteryAddress, String(currentBatteryStatus));
-            Serial.println(String("Reporting battery finished!"));
+            publishedCycles = temperatureCycles;
+
+            Reading reading = currentReading();
+            publishReading(reading);
+            // Only the newest reading is of interest to the reporting task
+            xQueueOverwrite(readingQueue, &reading);
         }
+
+        updateHistory();
+
+        observeHistogram(metrics.loopDuration, LOOP_DURATION_BOUNDS_MS, hal.millis() - start);
+        vTaskDelay(TICKS_SAMPLING_IDLE);
     }
 }
 
-void runReporting()
+// Reports the readings of the sampling task, settings changed by the web server are applied here as well
+// since they are mostly about reporting
+void reportingTask(void *parameter)
 {
-    runThermometerReporting();
-    runBatteryReporting();
-
-    if (settingPassive)
+    Reading reading;
+    bool received = false;
+    for (;;)
     {
-        long timeAwake = millis() - millisStart;
-        Serial.println(String("Passive mode active and thus going to deep sleep. Time awake: ") + String(timeAwake) + String(" milliseconds"));
-        initiateDeepSleepForReporting();
-    }
+        if (xQueueReceive(readingQueue, &reading, TICKS_REPORTING_WAIT) == pdTRUE)
+            received = true;
 
-    Serial.println(String("Reporting finished! Next update in '") + String(settingIntervalSecs) + String("' seconds!"));
+        applyChangedSettings();
+
+        if (received)
+            handleReporting(reading);
+    }
 }
 
-unsigned long lastReportingChecked = 0;
-void handleReporting()
+// Only used in active mode, passive mode samples and reports once per wake in loop()
+void startTasks()
 {
-    if (settingActivateReporting)
-    {
-        unsigned long now = millis();
-        if (lastReportingChecked == 0 || lastReportingChecked + settingIntervalSecs * 1000 < now || lastReportingChecked > now)
-        {
-            Serial.println("Reporting executing...");
-            lastReportingChecked = millis();
-            runReporting();
-        }
-    }
+    publishReading(currentReading());
+    readingQueue = xQueueCreate(1, sizeof(Reading));
+
+    xTaskCreatePinnedToCore(samplingTask, "sampling", STACK_SIZE_SAMPLING_TASK, NULL, 1, NULL, CORE_SAMPLING_TASK);
+    xTaskCreatePinnedToCore(reportingTask, "reporting", STACK_SIZE_REPORTING_TASK, NULL, 1, NULL, CORE_REPORTING_TASK);
 }
 
 void setup()
 {
-    Serial.begin(9600);
+    // Only passive mode sleeps with a timer, those wakes skip the reset check and the serial output
+    bool timerWake = esp_sleep_get_wakeup_cause() == ESP_SLEEP_WAKEUP_TIMER;
+
+    if (!timerWake)
+    {
+        Serial.begin(9600);
+        serialStarted = true;
+    }
     analogSetAttenuation(ADC_11db);
     analogReadResolution(11);
 
-    delay(10);
-    Serial.println("RAW:");
-    Serial.println(String(analogRead(PIN_BATTERY_MONITORING)));
-
-    millisStart = millis();
+    millisStart = hal.millis();
 
-    if (checkHallForReset())
+    unsigned long phaseStart;
+    if (!timerWake)
     {
-        Serial.println("Hall sensor threshold exceeded! Resetting settings...");
-        EspWifiSetup::resetSettings();
-        resetSettings();
+        LOG_LINE("RAW:");
+        LOG_LINE(String(analogRead(PIN_BATTERY_MONITORING)));
+
+        phaseStart = hal.millis();
+        bool resetRequested = checkHallForReset();
+        endPhase(PHASE_HALL, phaseStart);
+
+        if (resetRequested)
+        {
+            LOG_LINE("Hall sensor threshold exceeded! Resetting settings...");
+            EspWifiSetup::resetSettings();
+            resetSettings();
+        }
     }
 
-    Serial.println("Reading settings...");
+    LOG_LINE("Reading settings...");
+    phaseStart = hal.millis();
     readSettings();
-    Serial.println("Settings read!");
+    publishSamplingSettings();
+    endPhase(PHASE_SETTINGS, phaseStart);
+    LOG_LINE("Settings read!");
 
-    Serial.println("Setting up wifi...");
-    if (!EspWifiSetup::setup(String("Thermometer-") + settingSensorName, false, settingPassive) && settingPassive)
+    if (timerWake && !settingPassive)
     {
-        initiateDeepSleepForReporting();
+        Serial.begin(9600);
+        serialStarted = true;
+    }
+
+    if (isBatchSampling())
+    {
+        readValues();
+        bufferSample();
+        LOG_LINE(String("Sample buffered (") + String(sampleBuffer.samples.count) + String(" in buffer, ") + String(sampleBuffer.samples.length) + String(" bytes)"));
+
+        if (!isUploadDue())
+            initiateDeepSleepForReporting();
+    }
+    else if (settingPassive && settingDeadband)
+    {
+        // Deciding before WiFi is started whether this wake needs to report at all
+        readValues();
+
+        if (!isReportDue(currentReading()))
+        {
+            LOG_LINE("Values within deadband, going back to sleep!");
+            initiateDeepSleepForReporting();
+        }
+    }
+
+    LOG_LINE("Setting up wifi...");
+    millisWifiStart = hal.millis();
+    if (settingPassive && connectWifiFromCache())
+    {
+        wifiFromCache = true;
+    }
+    else
+    {
+        if (!EspWifiSetup::setup(String("Thermometer-") + settingSensorName, false, settingPassive) && settingPassive)
+        {
+            initiateDeepSleepForReporting();
+        }
+
+        if (settingPassive)
+            storeWifiCache();
     }
-    Serial.println("WiFi successfully set up!");
+    millisWifiDone = hal.millis();
+    endPhase(PHASE_WIFI, millisWifiStart);
+    LOG_LINE(String("WiFi successfully set up") + String(wifiFromCache ? " from cache!" : "!"));
+
+    setupSensors();
 
-    Serial.println("Setting up sensors");
-    sensors.begin();
-    Serial.println("Sensors set up!");
+    if (settingLogReadings)
+        readingLogStarted = beginReadingLog(hal);
+
+    if (settingReportingBackend == REPORTING_BACKEND_MQTT)
+        setupMqtt();
 
     if (!settingPassive)
     {
-        Serial.println("Setting up web server...");
+        startTasks();
+
+        LOG_LINE("Setting up web server...");
         setupWebServer();
-        Serial.println("Webserver set up!");
+        LOG_LINE("Webserver set up!");
+
+        setupMdns();
     }
     else
     {
-        Serial.println("Passive mode active");
+        LOG_LINE("Passive mode active");
     }
 }
 
 void loop()
 {
+    if (!settingPassive)
+    {
+        // Everything runs in the tasks started by startTasks()
+        vTaskDelete(NULL);
+    }
+
+    takeSamplingSettings();
     updateValues();
-    handleReporting();
-    delay(10);
+    handleTemperatureConversion();
+    updateHistory();
+    handleReporting(currentReading());
+
+    hal.delay(10);
 }
@@ -1,132 +1,119 @@
+// Generated by scripts/build_web_pages.py from RootPage.html, do not edit!
 #include <Arduino.h>
 
-const char rootPage[] PROGMEM = R"=====(
-<!DOCTYPE html>
-<html>
-  <head>
-    <meta name="viewport" content="width=device-width, initial-scale=1" />
-
-    <title>Thermometer</title>
-
-    <style>
-      body {
-        margin: 0;
-        padding: 30px;
-        background-color: white;
-        color: #535353;
-        font-family: "Trebuchet MS", "Lucida Sans Unicode", "Lucida Grande", "Lucida Sans", Arial, sans-serif;
-      }
-
-      body > h1 {
-        margin-top: 10px;
-      }
-
-      .temperatureLabel {
-        width: 120px;
-        font-size: 4em;
-        display: block;
-        margin-bottom: 10px;
-      }
-
-      .row {
-        width: 100%;
-        padding-left: 10px;
-        margin-top: 30px;
-      }
-
-      .openSettingsButton {
-        height: 40px;
-        border-radius: 5px;
-        border-width: 5px;
-        border-style: hidden;
-        width: 150px;
-        font-size: 1.1em;
-      }
-
-      @media (min-width: 576px) {
-        .inputLabel {
-          display: inline-block;
-        }
-
-        .inputLabel {
-          margin-bottom: 0;
-        }
-      }
-    </style>
-
-    <script>
-      var headingThermometer;
-
-      function loadAndFillHeadings() {
-        var xhr = new XMLHttpRequest();
-
-        xhr.open("GET", "/settings", true);
-        xhr.setRequestHeader("Content-Type", "application/json");
-
-        xhr.onreadystatechange = function() {
-          if (xhr.readyState === 4) {
-            if (xhr.status === 200) {
-              settingsObject = JSON.parse(xhr.responseText);
-
-              // Setting title
-              var name = "Thermometer-" + settingsObject.name;
-              window.document.title = name;
-              headingThermometer.innerText = name;
-            } else {
-              window.alert("Could not retrieve settings!");
-            }
-          }
-        };
-
-        xhr.send(null);
-      }
-
-      function updateTemperature() {
-        var xhr = new XMLHttpRequest();
-
-        xhr.open("GET", "/temperature", true);
-
-        xhr.onreadystatechange = function() {
-          if (xhr.readyState === 4) {
-            if (xhr.status === 200) {
-              var temp = parseFloat(xhr.responseText).toFixed(1);
-
-              textTemperature.innerText = temp + "\u00b0C";
-            } else {
-              console.log("Could not retrieve temperature!");
-              textTemperature.innerText = "NaN";
-            }
-          }
-        };
-
-        xhr.send(null);
-      }
-
-      window.onload = () => {
-        headingThermometer = document.getElementById("headingThermometer");
-        textTemperature = document.getElementById("textTemperature");
-
-        loadAndFillHeadings();
-
-        updateTemperature();
-        window.setInterval(updateTemperature, 5000);
-      };
-    </script>
-  </head>
-
-  <body>
-    <h1 style="font-size: 3em" id="headingThermometer">Thermometer</h1>
-    <hr />
-    <div class="row">
-      <span class="temperatureLabel" id="textTemperature"></span>
-    </div>
-    <div class="row">
-      <button class="openSettingsButton" id="openSettingsButton" onclick="location.href = '/settingsPage';">
-        Open settings
-      </button>
-    </div>
-  </body>
-</html>
-
-
-)=====";
\ No newline at end of file
+const char rootPageEtag[] = "\"202396e3f658fa88\"";
+const size_t rootPageLength = 1778;
+const uint8_t rootPage[] PROGMEM = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xad, 0x58, 0x5b, 0x6f, 0xe3, 0xb6,
+    0x12, 0x7e, 0xd7, 0xaf, 0xe0, 0xaa, 0x38, 0xad, 0xdc, 0xd8, 0xb2, 0x9d, 0xdd, 0xb4, 0x40, 0x1c,
+    0x07, 0xa7, 0x4d, 0xb3, 0xdd, 0x16, 0x7b, 0x43, 0xe3, 0xe2, 0xb4, 0x68, 0xfb, 0x40, 0x4b, 0x63,
+    0x8b, 0xbb, 0x14, 0xa9, 0x52, 0x94, 0x2f, 0x2d, 0xfc, 0xdf, 0x3b, 0x43, 0x51, 0xb2, 0xe4, 0x18,
+    0x29, 0xb0, 0x38, 0x48, 0x00, 0x4b, 0xc3, 0x99, 0xe1, 0xc7, 0xb9, 0x53, 0x37, 0xcf, 0xbe, 0x7b,
+    0x77, 0xb7, 0xf8, 0xf5, 0xfd, 0x3d, 0xcb, 0x6c, 0x2e, 0x6f, 0x83, 0x9b, 0xe6, 0x07, 0x78, 0x8a,
+    0x3f, 0x39, 0x58, 0xce, 0x14, 0xcf, 0x61, 0x1e, 0x6e, 0x04, 0x6c, 0x0b, 0x6d, 0x6c, 0xc8, 0x12,
+    0xad, 0x2c, 0x28, 0x3b, 0x0f, 0xb7, 0x22, 0xb5, 0xd9, 0x3c, 0x85, 0x8d, 0x48, 0x60, 0xe4, 0x5e,
+    0x86, 0x4c, 0x28, 0x61, 0x05, 0x97, 0xa3, 0x32, 0xe1, 0x12, 0xe6, 0xd3, 0x90, 0x8d, 0x51, 0x8d,
+    0x15, 0x56, 0xc2, 0xed, 0x22, 0x03, 0x93, 0x6b, 0x54, 0x09, 0xe6, 0x66, 0x5c, 0x93, 0x82, 0x9b,
+    0xd2, 0xee, 0xe9, 0x77, 0xa9, 0xd3, 0x3d, 0xfb, 0x3b, 0xc8, 0xb9, 0x59, 0x0b, 0x75, 0xcd, 0x26,
+    0xb3, 0xa0, 0xe0, 0x69, 0x2a, 0xd4, 0xfa, 0x9a, 0x3d, 0x9f, 0x14, 0xbb, 0x59, 0xb0, 0xe4, 0xc9,
+    0xc7, 0xb5, 0xd1, 0x95, 0x4a, 0x47, 0x89, 0x96, 0xda, 0x5c, 0xb3, 0x6d, 0x26, 0x2c, 0xcc, 0x02,
+    0xff, 0xf6, 0xd9, 0xd5, 0x73, 0xfa, 0x9b, 0x05, 0x2b, 0x44, 0x37, 0x5a, 0xf1, 0x5c, 0xc8, 0xfd,
+    0x35, 0x0b, 0x17, 0x06, 0x96, 0x55, 0x92, 0x81, 0x65, 0x6f, 0x1e, 0xc2, 0x21, 0x0b, 0x5f, 0x57,
+    0x89, 0x48, 0x39, 0x7b, 0xe0, 0xaa, 0x64, 0x3f, 0x2b, 0x91, 0xe8, 0x14, 0x3a, 0xe4, 0xef, 0x0d,
+    0x57, 0x3d, 0x02, 0xf1, 0xe1, 0xeb, 0x37, 0x06, 0x8f, 0x34, 0x64, 0x25, 0xbe, 0x8d, 0x4a, 0x30,
+    0x62, 0x35, 0x0b, 0x0e, 0x35, 0xe4, 0x5b, 0x96, 0x4d, 0x5b, 0xdc, 0x23, 0xab, 0x8b, 0x6b, 0x36,
+    0x75, 0x78, 0x0f, 0x41, 0x6c, 0x21, 0x2f, 0xc0, 0x70, 0x5b, 0x19, 0x78, 0xcd, 0x97, 0x20, 0x91,
+    0xcf, 0x19, 0x09, 0x59, 0x2e, 0x1d, 0x8f, 0x83, 0x5a, 0x8a, 0xbf, 0xe0, 0x9a, 0xbd, 0x80, 0x7c,
+    0x16, 0xa4, 0xa2, 0x2c, 0x24, 0x47, 0xd8, 0x4b, 0xa9, 0x93, 0x8f, 0xb3, 0x46, 0xeb, 0x52, 0x5b,
+    0xab, 0xf3, 0x8e, 0x62, 0xa3, 0xb7, 0x1d, 0x5d, 0x93, 0xc9, 0x7f, 0x5a, 0x6b, 0x8d, 0x24, 0xac,
+    0x6c, 0xc3, 0xd9, 0x05, 0xf5, 0xbc, 0x91, 0xcd, 0x44, 0x69, 0xb5, 0xd9, 0xdf, 0x65, 0xdc, 0xd8,
+    0x53, 0x25, 0x39, 0xdf, 0x8d, 0x3c, 0xe1, 0xab, 0x89, 0x13, 0xc8, 0x40, 0xac, 0x33, 0x54, 0x78,
+    0x39, 0x69, 0xe4, 0x75, 0x01, 0xea, 0x01, 0xac, 0xc5, 0xcd, 0xca, 0x6f, 0x2b, 0x04, 0xa6, 0x50,
+    0x4b, 0xc3, 0xf6, 0xa2, 0x76, 0x95, 0x36, 0x29, 0x98, 0x91, 0xe1, 0xa9, 0xa8, 0xca, 0x6b, 0x76,
+    0xd5, 0xa1, 0x79, 0xed, 0x5d, 0x92, 0x0b, 0x80, 0x6b, 0x96, 0x89, 0x34, 0x05, 0x35, 0x6b, 0x01,
+    0x5d, 0x9d, 0x5a, 0x68, 0x1a, 0x4f, 0xc9, 0x46, 0x87, 0xe0, 0xbf, 0x39, 0xa4, 0x82, 0xb3, 0x28,
+    0xc7, 0xb3, 0x35, 0xfa, 0xbe, 0xfe, 0xaa, 0xd8, 0x0d, 0x10, 0x48, 0x2c, 0x54, 0x51, 0xd9, 0xc6,
+    0xda, 0xad, 0x3d, 0x85, 0x92, 0x42, 0xc1, 0xc8, 0x9b, 0xf5, 0x70, 0xc2, 0x76, 0x62, 0xe6, 0x09,
+    0x71, 0x1c, 0x82, 0x9b, 0xb1, 0x0f, 0xcd, 0x9b, 0x32, 0x31, 0xa2, 0xb0, 0xb7, 0xc1, 0x86, 0x1b,
+    0x46, 0x79, 0x81, 0x47, 0xef, 0x84, 0xf2, 0xcc, 0xd1, 0x0b, 0x2d, 0x71, 0x8b, 0xf5, 0x0f, 0x98,
+    0x19, 0x66, 0xc3, 0x25, 0x9b, 0x33, 0x55, 0x49, 0x89, 0x07, 0xa8, 0x54, 0x62, 0x05, 0x1a, 0x49,
+    0x6a, 0x9e, 0x7e, 0xa3, 0xd2, 0x97, 0x42, 0xca, 0x57, 0xb5, 0x8e, 0x32, 0x22, 0xc4, 0x24, 0xbc,
+    0xcb, 0x0c, 0x09, 0xc0, 0x96, 0xfd, 0xf2, 0xe6, 0xf5, 0x2b, 0x6b, 0x8b, 0x9f, 0xe0, 0xcf, 0x0a,
+    0x4a, 0x1b, 0x0d, 0x66, 0x01, 0xae, 0x39, 0x9b, 0x47, 0xe1, 0xf7, 0xf7, 0x0b, 0x8a, 0xcc, 0x71,
+    0xe9, 0xad, 0x8f, 0x2f, 0xd6, 0x54, 0xe0, 0x79, 0x90, 0xea, 0xa5, 0x48, 0x3d, 0x98, 0x28, 0xbc,
+    0xab, 0xd3, 0x74, 0xb4, 0xd8, 0x17, 0x2e, 0xa4, 0x79, 0x51, 0x48, 0x91, 0x70, 0x42, 0x33, 0xfe,
+    0x50, 0x6a, 0x15, 0x36, 0xda, 0x95, 0x41, 0x89, 0x7d, 0x69, 0xb9, 0x85, 0x24, 0xe3, 0x6a, 0x0d,
+    0x08, 0xa6, 0xc1, 0xed, 0x30, 0x8a, 0x15, 0x8b, 0x88, 0xd3, 0xf1, 0x3d, 0x10, 0x1f, 0x9b, 0xcf,
+    0xe7, 0xec, 0x45, 0x77, 0x8d, 0xc4, 0xab, 0xd2, 0xd1, 0x31, 0x58, 0x68, 0xa5, 0xc1, 0xf9, 0x6e,
+    0xf9, 0x01, 0x12, 0x8b, 0x3a, 0x7f, 0x7c, 0x78, 0xf7, 0x36, 0x2e, 0xb8, 0x29, 0xc1, 0x6b, 0x2b,
+    0x0b, 0xad, 0x4a, 0x58, 0xc0, 0xce, 0x22, 0x94, 0xf1, 0x98, 0xf9, 0xb8, 0x62, 0xae, 0x36, 0x38,
+    0xcb, 0x50, 0xe9, 0x41, 0xc9, 0xb0, 0x63, 0xef, 0x51, 0xc8, 0x2e, 0x58, 0x5f, 0x77, 0x4c, 0x6c,
+    0x14, 0x3a, 0x2a, 0xd5, 0xdb, 0x38, 0xd5, 0x49, 0x95, 0xe3, 0xc1, 0x63, 0xa7, 0x86, 0x0c, 0xeb,
+    0x56, 0x1f, 0x7b, 0x0e, 0xa3, 0x40, 0x81, 0xa1, 0xed, 0x5b, 0xa6, 0x03, 0x03, 0x59, 0x82, 0xcb,
+    0x0b, 0xa7, 0x0b, 0x6b, 0x98, 0xb1, 0x64, 0xca, 0x4a, 0xa6, 0x4c, 0x69, 0xcb, 0x0c, 0x58, 0x23,
+    0x60, 0x03, 0x2d, 0x82, 0x67, 0x64, 0x46, 0x8a, 0x97, 0x43, 0xe3, 0x07, 0x95, 0x46, 0xe4, 0x7b,
+    0x47, 0x6e, 0xdd, 0x5f, 0x66, 0x7a, 0xbb, 0x38, 0xd6, 0x83, 0x08, 0x63, 0x04, 0x5d, 0xe7, 0xfd,
+    0x4f, 0x85, 0x02, 0x21, 0x38, 0xd3, 0xbc, 0xc4, 0x40, 0xb1, 0x7e, 0x39, 0xb6, 0xfa, 0xa5, 0xd8,
+    0x41, 0x1a, 0x4d, 0x51, 0x99, 0x45, 0x9c, 0x1d, 0x0d, 0x3d, 0xf0, 0x4e, 0xc1, 0x05, 0x0b, 0x7f,
+    0xaf, 0x26, 0x93, 0xe5, 0xe4, 0x2e, 0xec, 0x6f, 0x6d, 0x31, 0xd5, 0xdf, 0xd7, 0xf1, 0xd9, 0xba,
+    0xf3, 0x51, 0xbc, 0xd6, 0x01, 0x4b, 0xcb, 0x55, 0x91, 0xa2, 0x87, 0xbb, 0x60, 0x71, 0xf7, 0xc7,
+    0xf1, 0xed, 0x2d, 0x84, 0x76, 0x68, 0x88, 0xd1, 0x23, 0xc9, 0x21, 0xbb, 0x9a, 0x60, 0x30, 0xd4,
+    0x06, 0x3a, 0x02, 0xaa, 0x96, 0x94, 0x52, 0xcb, 0xfe, 0x1e, 0x1e, 0xd8, 0x33, 0xaf, 0xf7, 0x7e,
+    0x83, 0x2e, 0x7c, 0xd0, 0x95, 0x49, 0x9c, 0x99, 0xfa, 0x87, 0x98, 0x05, 0xe8, 0x87, 0xca, 0x28,
+    0x52, 0x4c, 0x06, 0x2c, 0x1d, 0x9f, 0xcf, 0xa1, 0x8e, 0x64, 0x14, 0x8e, 0x81, 0xde, 0x4a, 0x72,
+    0x12, 0x31, 0x52, 0x26, 0x41, 0x4a, 0xf1, 0xcd, 0xd1, 0xcf, 0xb3, 0xa0, 0x16, 0x8c, 0xb1, 0x78,
+    0x3a, 0xa9, 0xd7, 0x58, 0x1c, 0x91, 0x01, 0x93, 0x87, 0x18, 0x31, 0x69, 0x10, 0xd6, 0xfc, 0x16,
+    0xb7, 0x6f, 0xe5, 0x28, 0xe3, 0x70, 0xd7, 0xc1, 0x13, 0xa2, 0x9d, 0xb2, 0x8f, 0x1a, 0xdc, 0xfe,
+    0xb5, 0x92, 0xd3, 0x18, 0x70, 0x4b, 0x31, 0x9a, 0x8c, 0x0f, 0xfe, 0x45, 0x25, 0x18, 0xa3, 0x4d,
+    0x07, 0x0e, 0xe6, 0xca, 0x4b, 0xee, 0x6c, 0xc1, 0xa8, 0x2f, 0x32, 0xab, 0x9b, 0x02, 0xc4, 0xd0,
+    0x86, 0x36, 0xc3, 0xf0, 0xb4, 0x98, 0xac, 0x39, 0x13, 0xa5, 0x8b, 0x5a, 0xbe, 0xe1, 0x42, 0xf2,
+    0x25, 0x66, 0x03, 0xc7, 0x17, 0x89, 0xad, 0x4c, 0x23, 0x93, 0xd9, 0x0a, 0x8c, 0xf5, 0x8e, 0xb9,
+    0x30, 0xba, 0xb1, 0xb7, 0x2b, 0xcc, 0xa8, 0x92, 0x2d, 0xf7, 0x4c, 0xd8, 0x12, 0xe4, 0xaa, 0xf6,
+    0x4a, 0x6d, 0x00, 0xe7, 0x89, 0x1a, 0x64, 0x22, 0x75, 0xe9, 0x22, 0xe3, 0xd4, 0x33, 0x07, 0x77,
+    0x94, 0x43, 0xbf, 0xf2, 0xbd, 0xaa, 0xbb, 0xce, 0x27, 0x56, 0x3c, 0xdf, 0xb3, 0xfa, 0x05, 0xef,
+    0xd3, 0xcb, 0x16, 0xfb, 0xfc, 0x73, 0x76, 0xbe, 0x64, 0xb9, 0x58, 0xe2, 0x79, 0x21, 0x01, 0xc9,
+    0xec, 0xb4, 0x48, 0x61, 0x47, 0x37, 0x22, 0x8f, 0x06, 0x41, 0x8c, 0x6d, 0x45, 0x60, 0x59, 0xf8,
+    0x1d, 0x6b, 0x28, 0xbe, 0x60, 0x55, 0x05, 0x4c, 0xd1, 0x20, 0xce, 0x79, 0x11, 0x51, 0xa3, 0x21,
+    0x27, 0xd1, 0x6f, 0xc3, 0x37, 0x0c, 0x07, 0x6e, 0xed, 0x98, 0xe0, 0x03, 0x3c, 0x44, 0x6a, 0xf8,
+    0xb6, 0xb1, 0x8b, 0xdf, 0xb4, 0x36, 0xdf, 0x93, 0x85, 0xe4, 0x9c, 0x94, 0x47, 0x9e, 0x70, 0xb5,
+    0xe1, 0x04, 0xbc, 0xad, 0x80, 0x6b, 0xb0, 0xf7, 0x12, 0xe8, 0xf1, 0xdb, 0xfd, 0x0f, 0x69, 0x14,
+    0x76, 0x9b, 0x7f, 0x93, 0x12, 0x6e, 0x9a, 0x73, 0x55, 0xa4, 0x96, 0x27, 0xa1, 0xbb, 0x9a, 0x16,
+    0x85, 0x97, 0x29, 0xb1, 0xf9, 0x05, 0xd7, 0x6c, 0x8f, 0x7c, 0x89, 0x14, 0xa8, 0xf8, 0x7f, 0x44,
+    0x6c, 0x59, 0xea, 0x41, 0xe0, 0x94, 0xe7, 0x95, 0xa3, 0xd2, 0xa8, 0xe6, 0xd4, 0x22, 0x15, 0xb8,
+    0xf9, 0x09, 0xc3, 0x2c, 0x9a, 0x0c, 0x19, 0xfe, 0x77, 0xf5, 0xb7, 0x6f, 0xb5, 0x2a, 0xdc, 0x9d,
+    0xdc, 0xe8, 0x4f, 0x1a, 0x4b, 0x50, 0x6b, 0xc4, 0x70, 0xc3, 0x2e, 0xe9, 0xd0, 0xfd, 0x22, 0x40,
+    0x79, 0x47, 0xa7, 0x6f, 0x78, 0xc9, 0xe2, 0xf5, 0x33, 0xf9, 0xa3, 0x7e, 0xfa, 0x6d, 0xfa, 0x87,
+    0x3f, 0x36, 0x4e, 0x0f, 0x8b, 0xba, 0xec, 0xbe, 0xe1, 0x36, 0x8b, 0x57, 0x52, 0x6b, 0x13, 0xb9,
+    0x47, 0x5c, 0x89, 0xe2, 0xd8, 0x4d, 0x6f, 0xe5, 0xa0, 0xe1, 0xe6, 0xbb, 0x2e, 0x77, 0x02, 0x42,
+    0x7a, 0x66, 0xbe, 0xeb, 0x31, 0x13, 0xd8, 0x96, 0x79, 0xde, 0xec, 0x32, 0x70, 0x53, 0x86, 0xa3,
+    0x5e, 0x5c, 0x34, 0x78, 0x57, 0xc2, 0x94, 0x76, 0x21, 0x5c, 0x83, 0xf3, 0x98, 0x7f, 0x9b, 0xfc,
+    0x81, 0xff, 0xf5, 0x96, 0x92, 0x3f, 0x5a, 0x3d, 0xb1, 0xc2, 0x88, 0x4d, 0x8f, 0xec, 0x7e, 0x00,
+    0x64, 0x14, 0xcb, 0x47, 0x4b, 0x63, 0x19, 0xd0, 0x1f, 0xe1, 0x81, 0x06, 0x19, 0x6a, 0xa3, 0x7e,
+    0x48, 0x0e, 0x8f, 0x0c, 0x4b, 0xc0, 0xd1, 0xe7, 0x3d, 0x9e, 0xc4, 0xa5, 0xb2, 0xd7, 0xbf, 0xd2,
+    0xe6, 0x9e, 0x27, 0x59, 0xe4, 0xcd, 0x87, 0x43, 0xbd, 0xaf, 0x3b, 0x2e, 0x75, 0x5d, 0xa7, 0xaa,
+    0x37, 0xbb, 0x60, 0x0d, 0x0f, 0xe2, 0x40, 0x3c, 0xed, 0x91, 0x06, 0x6c, 0xcc, 0x5a, 0xfb, 0xb4,
+    0x27, 0xe9, 0x30, 0x0c, 0xd9, 0x74, 0x30, 0x60, 0x5f, 0xb2, 0xa8, 0x17, 0x5b, 0x23, 0x76, 0x89,
+    0x34, 0xaf, 0xdd, 0x9b, 0x7e, 0x7f, 0x8c, 0x26, 0x1f, 0x5d, 0xa3, 0x76, 0xff, 0xd1, 0x71, 0xff,
+    0x29, 0xed, 0xdf, 0x9a, 0x7b, 0x7c, 0xf4, 0xc2, 0x91, 0xda, 0xdd, 0xaf, 0x55, 0xd5, 0xdf, 0x90,
+    0xdc, 0x27, 0xc8, 0x71, 0xae, 0x1c, 0x34, 0x46, 0xca, 0xf5, 0x06, 0x16, 0x3a, 0xda, 0x0d, 0xd9,
+    0x7e, 0xd0, 0x99, 0x11, 0x9a, 0x65, 0x4a, 0xf5, 0xce, 0xb2, 0xab, 0x7f, 0x7d, 0x07, 0x44, 0x1d,
+    0xca, 0x0a, 0x27, 0xc0, 0x27, 0x1c, 0x42, 0xcb, 0x54, 0x6c, 0x5a, 0xfc, 0x9d, 0xb6, 0xee, 0x92,
+    0xe5, 0x78, 0xf6, 0xab, 0xc1, 0x39, 0x31, 0x1f, 0xd7, 0xa7, 0x62, 0xa7, 0xe7, 0xbe, 0xea, 0x97,
+    0x95, 0x33, 0x4d, 0xff, 0x93, 0x4a, 0x75, 0xbf, 0xf9, 0xfd, 0x5f, 0xca, 0xf5, 0xbf, 0x4c, 0x99,
+    0x27, 0x4d, 0xf5, 0xcc, 0x64, 0xd9, 0x75, 0x58, 0xa9, 0x25, 0xc4, 0x52, 0xaf, 0xcf, 0xce, 0x74,
+    0x1d, 0xf0, 0x6e, 0xac, 0x7b, 0x6a, 0xe4, 0x0a, 0xdf, 0xf2, 0xb7, 0xe1, 0x13, 0x93, 0x9f, 0x1f,
+    0x63, 0xb4, 0xa2, 0xf6, 0x87, 0xfc, 0x4d, 0xeb, 0x7e, 0x3c, 0x86, 0x3e, 0x59, 0xb0, 0x1f, 0x71,
+    0x9f, 0xc1, 0xf5, 0x94, 0x82, 0x13, 0x56, 0x92, 0x3e, 0x7b, 0x13, 0x99, 0x9d, 0x1f, 0xfb, 0xce,
+    0x8f, 0x6a, 0xb5, 0x8e, 0xb6, 0xa7, 0xb7, 0x93, 0x77, 0x77, 0x16, 0xec, 0x70, 0x0c, 0xe9, 0x36,
+    0x59, 0x8f, 0x81, 0x33, 0xba, 0x56, 0xf9, 0xeb, 0xd4, 0xcd, 0xd8, 0x7f, 0x64, 0xa0, 0x8b, 0x34,
+    0x7d, 0x72, 0x98, 0x32, 0x77, 0xe3, 0x9a, 0x87, 0x9d, 0x5b, 0xdf, 0x73, 0xc8, 0x43, 0x26, 0xd2,
+    0xf9, 0x39, 0x4b, 0xf4, 0x3f, 0x28, 0x64, 0x53, 0xd2, 0x61, 0xdc, 0xf7, 0x86, 0x54, 0x6c, 0x58,
+    0x82, 0x65, 0xa7, 0x9c, 0x87, 0x78, 0x57, 0x0e, 0xe9, 0x0e, 0x57, 0x70, 0xd5, 0x90, 0x4e, 0xef,
+    0xe5, 0xf5, 0x06, 0xa7, 0x96, 0xba, 0x45, 0xa4, 0x28, 0x44, 0x38, 0x51, 0xdd, 0x59, 0xa5, 0xbe,
+    0xe1, 0x7a, 0x62, 0xaf, 0xb9, 0xd6, 0x98, 0xbb, 0x14, 0xd4, 0x57, 0xf3, 0x3f, 0xa5, 0x71, 0x59,
+    0xdf, 0xa8, 0x3d, 0xf1, 0xf1, 0x5d, 0xbb, 0xd6, 0x7b, 0x8e, 0xae, 0x15, 0xf6, 0xda, 0xe4, 0xe3,
+    0x3c, 0xc4, 0x3b, 0xae, 0xbb, 0xe3, 0xc5, 0x99, 0x81, 0x15, 0x86, 0xc6, 0x17, 0xed, 0x85, 0xf1,
+    0x3d, 0x5f, 0xc3, 0x17, 0x33, 0xdc, 0xe6, 0x1d, 0xca, 0xb7, 0x17, 0x18, 0x44, 0x53, 0xef, 0x7a,
+    0xc4, 0x35, 0xf6, 0x1e, 0x19, 0xbb, 0x8f, 0x41, 0xff, 0x00, 0xdb, 0xad, 0x8e, 0x08, 0x23, 0x12,
+    0x00, 0x00,
+};
@@ -1,277 +1,254 @@
+// Generated by scripts/build_web_pages.py from SettingsPage.html, do not edit!
 #include <Arduino.h>
 
-const char settingsPage[] PROGMEM = R"=====(
-<!DOCTYPE html>
-<html>
-  <head>
-    <meta name="viewport" content="width=device-width, initial-scale=1" />
-
-    <title>Thermometer</title>
-
-    <style>
-      body {
-        margin: 0;
-        padding: 30px;
-        background-color: white;
-        color: #535353;
-        font-family: "Trebuchet MS", "Lucida Sans Unicode", "Lucida Grande", "Lucida Sans", Arial, sans-serif;
-      }
-
-      h1 {
-        margin-top: 10px;
-      }
-
-      h2 {
-        padding-top: 20px;
-        margin-bottom: 3px;
-      }
-
-      .textInput {
-        border-radius: 5px;
-        border-style: solid;
-        border-width: 1px;
-        border-color: darkgray;
-        height: 25px;
-        max-width: 300px;
-        min-width: 150px;
-        width: 100%;
-        padding-left: 5px;
-      }
-
-      ::placeholder {
-        font-style: italic;
-        color: #bbbbbb;
-      }
-
-      .textInputShort {
-        border-radius: 5px;
-        border-style: solid;
-        border-width: 1px;
-        border-color: darkgray;
-        height: 25px;
-        max-width: 80px;
-        min-width: 30px;
-      }
-
-      .inputLabel {
-        width: 135px;
-        font-size: 1.3em;
-        display: block;
-        margin-bottom: 10px;
-      }
-
-      .inputLabelNotWrapping {
-        width: 135px;
-        font-size: 1.3em;
-        display: inline-block;
-        margin-bottom: 10px;
-      }
-
-      .inputRow {
-        width: 100%;
-        padding-left: 10px;
-        margin-top: 20px;
-      }
-
-      .submitButton {
-        height: 40px;
-        border-radius: 5px;
-        border-width: 5px;
-        border-style: hidden;
-        width: 80px;
-        font-size: 1.1em;
-      }
-
-      .checkboxInput {
-        width: 20px;
-        height: 20px;
-      }
-
-      @media (min-width: 576px) {
-        .inputLabel {
-          display: inline-block;
-          margin-bottom: 0;
-        }
-      }
-    </style>
-
-    <script>
-      var submitButton;
-      var nameInput;
-      var activateReportingInput;
-      var editAddressInput;
-      var intervalSecsInput;
-      var activatePassiveInput;
-      var activateReportingBatteryInput;
-      var editAddressBatteryInput;
-
-      window.onload = () => {
-        determineHtmlObjects();
-
-        loadAndFillSettings();
-
-        submitButton.addEventListener("click", () => {
-          settingsResult = checkSettings();
-
-          if (!settingsResult.success) {
-            window.alert(settingsResult.message);
-          } else {
-            xhr = new XMLHttpRequest();
-
-            xhr.open("POST", "/settings", true);
-            xhr.setRequestHeader("Content-Type", "application/json");
-
-            xhr.onreadystatechange = function() {
-              if (xhr.readyState === 4) {
-                if (xhr.status === 200) {
-                  window.alert("Settings updated successfully! ESP is going to restart...");
-
-                  location.href = "/";
-                } else {
-                  window.alert("Something went wrong!");
-                }
-              }
-            };
-
-            xhr.send(JSON.stringify(settingsResult.settings));
-          }
-        });
-      };
-
-      function checkSettings() {
-        checkResult = {};
-        checkResult.settings = {};
-        checkResult.success = false;
-        checkResult.message = "";
-
-        nameSetting = nameInput.value;
-        activateReportingSetting = activateReportingInput.checked;
-        editAddressSetting = editAddressInput.value;
-        intervalSecsSetting = intervalSecsInput.value;
-        activatePassiveSetting = activatePassiveInput.checked;
-        activateBatteryReportingSetting = activateReportingBatteryInput.checked;
-        editAddressBatterySetting = editAddressBatteryInput.value;
-
-        if (nameSetting.length == 0) {
-          checkResult.message = "Field 'Name' must not be empty!";
-        } else if (activateReportingSetting && editAddressSetting.length == 0) {
-          checkResult.message = "Field 'Address Temperature' must not be empty!";
-        } else if (activateBatteryReportingSetting && editAddressBatterySetting.length == 0) {
-          checkResult.message = "Field 'Address Battery' must not be empty!";
-        } else if (
-          activateReportingSetting &&
-          (intervalSecsSetting.length == 0 || intervalSecsSetting !== parseInt(intervalSecsSetting, 10).toString())
-        ) {
-          checkResult.message = "Field 'Interval secs' must not be empty!";
-        } else {
-          checkResult.success = true;
-
-          checkResult.settings.name = nameSetting;
-          checkResult.settings.activateRep = activateReportingSetting;
-          checkResult.settings.editAddress = editAddressSetting;
-          checkResult.settings.intervalSecs = intervalSecsSetting;
-          checkResult.settings.passive = activatePassiveSetting;
-          checkResult.settings.activateRepBat = activateBatteryReportingSetting;
-          checkResult.settings.editAddressBat = editAddressBatterySetting;
-        }
-
-        return checkResult;
-      }
-
-      function determineHtmlObjects() {
-        submitButton = document.getElementById("submitButton");
-        nameInput = document.getElementById("nameInput");
-        activateReportingInput = document.getElementById("activateReportingInput");
-        editAddressInput = document.getElementById("editAddressInput");
-        intervalSecsInput = document.getElementById("intervalSecsInput");
-        activatePassiveInput = document.getElementById("activatePassiveInput");
-        activateReportingBatteryInput = document.getElementById("activateReportingBatteryInput");
-        editAddressBatteryInput = document.getElementById("editAddressBatteryInput");
-      }
-
-      function loadAndFillSettings() {
-        xhr = new XMLHttpRequest();
-
-        xhr.open("GET", "/settings", true);
-        xhr.setRequestHeader("Content-Type", "application/json");
-
-        xhr.onreadystatechange = function() {
-          if (xhr.readyState === 4) {
-            if (xhr.status === 200) {
-              settingsObject = JSON.parse(xhr.responseText);
-
-              nameInput.value = settingsObject.name;
-              activateReportingInput.checked = settingsObject.activateRep;
-              editAddressInput.value = settingsObject.editAddress;
-              intervalSecsInput.value = settingsObject.intervalSecs;
-              activatePassiveInput.checked = settingsObject.passive;
-              activateReportingBatteryInput.checked = settingsObject.activateRepBat;
-              editAddressBatteryInput.value = settingsObject.editAddressBat;
-
-              // Setting title
-              window.document.title = "Thermometer-" + settingsObject.name;
-            } else {
-              window.alert("Could not retrieve settings!");
-            }
-          }
-        };
-
-        xhr.send(null);
-      }
-    </script>
-  </head>
-
-  <body>
-    <h1 style="font-size: 3em">Settings</h1>
-    <hr />
-    <div class="inputRow">
-      <h2>General</h2>
-    </div>
-    <div class="inputRow">
-      <span class="inputLabel">Name </span>
-      <input type="text" class="textInput" id="nameInput" />
-    </div>
-    <div class="inputRow">
-      <h2>Reporting</h2>
-    </div>
-    <div class="inputRow">
-      <span class="inputLabelNotWrapping">Activate</span>
-      <input class="checkboxInput" type="checkbox" id="activateReportingInput" />
-    </div>
-    <div class="inputRow">
-      <span class="inputLabel">Address Temperature</span>
-      <input
-        type="text"
-        class="textInput"
-        id="editAddressInput"
-        placeholder="e.g. http://openhab/api/items/temperature/state"
-      />
-    </div>
-    <div class="inputRow">
-      <span class="inputLabel">Interval secs</span>
-      <input type="text" class="textInputShort" id="intervalSecsInput" />
-    </div>
-    <div class="inputRow">
-      <span class="inputLabelNotWrapping">Battery reporting</span>
-      <input class="checkboxInput" type="checkbox" id="activateReportingBatteryInput" />
-    </div>
-    <div class="inputRow">
-      <span class="inputLabel">Address Battery</span>
-      <input
-        type="text"
-        class="textInput"
-        id="editAddressBatteryInput"
-        placeholder="e.g. http://openhab/api/items/sensor_battery/state"
-      />
-    </div>
-    <div class="inputRow">
-      <span class="inputLabelNotWrapping">Passive</span>
-      <input class="checkboxInput" type="checkbox" id="activatePassiveInput" />
-    </div>
-    <div class="inputRow">
-      <button class="submitButton" id="submitButton">Submit</button>
-    </div>
-  </body>
-</html>
-
-)=====";
\ No newline at end of file
+const char settingsPageEtag[] = "\"a5a7bbce6716e7e7\"";
+const size_t settingsPageLength = 3942;
+const uint8_t settingsPage[] PROGMEM = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xd5, 0x1c, 0x6b, 0x93, 0xdb, 0xb6,
+    0xf1, 0xbb, 0x7e, 0x05, 0xcc, 0x36, 0x89, 0x34, 0xf5, 0xe9, 0x79, 0x97, 0xd8, 0x77, 0x27, 0x25,
+    0xf6, 0xd9, 0xb1, 0xdd, 0xf1, 0xe3, 0x6c, 0xc9, 0xd3, 0x76, 0x52, 0xb7, 0x43, 0x91, 0xd0, 0x89,
+    0x31, 0x45, 0x32, 0x24, 0x74, 0x8f, 0xda, 0xfe, 0xef, 0x5d, 0x3c, 0x48, 0xe2, 0xc5, 0x87, 0xa4,
+    0x9b, 0xce, 0xd4, 0x8e, 0x7d, 0x16, 0xb0, 0xbb, 0xd8, 0x5d, 0x2c, 0xf6, 0x01, 0xac, 0x72, 0xfe,
+    0xe0, 0xd9, 0xbb, 0x8b, 0xc5, 0x3f, 0x2e, 0x9f, 0xa3, 0x35, 0xd9, 0x84, 0xb3, 0xce, 0x79, 0xfe,
+    0x03, 0xbb, 0x3e, 0xfc, 0xd8, 0x60, 0xe2, 0xa2, 0xc8, 0xdd, 0xe0, 0xa9, 0x73, 0x1d, 0xe0, 0x9b,
+    0x24, 0x4e, 0x89, 0x83, 0xbc, 0x38, 0x22, 0x38, 0x22, 0x53, 0xe7, 0x26, 0xf0, 0xc9, 0x7a, 0xea,
+    0xe3, 0xeb, 0xc0, 0xc3, 0x47, 0xec, 0xc3, 0x43, 0x14, 0x44, 0x01, 0x09, 0xdc, 0xf0, 0x28, 0xf3,
+    0xdc, 0x10, 0x4f, 0x47, 0x0e, 0x1a, 0x00, 0x19, 0x12, 0x90, 0x10, 0xcf, 0x16, 0x6b, 0x9c, 0x6e,
+    0x62, 0x20, 0x89, 0xd3, 0xf3, 0x01, 0x1f, 0xea, 0x9c, 0x67, 0xe4, 0x8e, 0xfe, 0x5c, 0xc6, 0xfe,
+    0x1d, 0xfa, 0xd2, 0xd9, 0xb8, 0xe9, 0x55, 0x10, 0x9d, 0xa2, 0xe1, 0x59, 0x27, 0x71, 0x7d, 0x3f,
+    0x88, 0xae, 0x4e, 0xd1, 0x64, 0x98, 0xdc, 0x9e, 0x75, 0x96, 0xae, 0xf7, 0xf9, 0x2a, 0x8d, 0xb7,
+    0x91, 0x7f, 0xe4, 0xc5, 0x61, 0x9c, 0x9e, 0xa2, 0x9b, 0x75, 0x40, 0xf0, 0x59, 0x47, 0x7c, 0xfa,
+    0xd3, 0xc9, 0x84, 0xfe, 0x3e, 0xeb, 0xac, 0x80, 0xbb, 0xa3, 0x95, 0xbb, 0x09, 0xc2, 0xbb, 0x53,
+    0xe4, 0x2c, 0x52, 0xbc, 0xdc, 0x7a, 0x6b, 0x4c, 0xd0, 0x9b, 0xb9, 0xf3, 0x10, 0x39, 0xaf, 0xb7,
+    0x5e, 0xe0, 0xbb, 0x68, 0xee, 0x46, 0x19, 0xfa, 0x18, 0x05, 0x5e, 0xec, 0x63, 0x69, 0xf8, 0x45,
+    0xea, 0x46, 0xca, 0x00, 0x85, 0x83, 0x8f, 0x4f, 0x52, 0x10, 0xe9, 0x21, 0xca, 0xe0, 0xd3, 0x51,
+    0x86, 0xd3, 0x60, 0x75, 0xd6, 0xf9, 0xd6, 0x59, 0x8f, 0x0a, 0x86, 0x8f, 0x48, 0x9c, 0x9c, 0xa2,
+    0x11, 0x63, 0x14, 0x26, 0xc6, 0x30, 0x21, 0xd8, 0xe7, 0x33, 0x63, 0x36, 0x23, 0x60, 0x97, 0x31,
+    0x21, 0xf1, 0x06, 0xe4, 0xe2, 0xd0, 0x7d, 0x82, 0x6f, 0xc9, 0xab, 0x28, 0xd9, 0x12, 0xc0, 0x5a,
+    0xc6, 0xa9, 0x8f, 0xd3, 0xa3, 0xd4, 0xf5, 0x83, 0x6d, 0x76, 0x8a, 0x4e, 0x98, 0xe4, 0x7c, 0x8c,
+    0x29, 0xea, 0x14, 0x65, 0x71, 0x18, 0xf8, 0xc5, 0x20, 0x53, 0x3a, 0xac, 0x2c, 0xc1, 0x09, 0x7d,
+    0xf8, 0x6e, 0x0a, 0xfa, 0x72, 0xef, 0xce, 0x3a, 0x6b, 0x1c, 0x5c, 0xad, 0x09, 0x30, 0x71, 0xc2,
+    0x99, 0xb8, 0xcd, 0xb1, 0x26, 0x43, 0xce, 0x16, 0xf0, 0x94, 0xd3, 0x39, 0x61, 0x23, 0xf9, 0xa7,
+    0xe1, 0xf0, 0xbb, 0x62, 0x1f, 0x8e, 0x42, 0xbc, 0x22, 0x82, 0xa3, 0x6f, 0x9d, 0xd3, 0xd3, 0x24,
+    0x74, 0x3d, 0xbc, 0x8e, 0x43, 0x58, 0x12, 0xf8, 0x66, 0x4a, 0x17, 0x1c, 0x06, 0xc4, 0x0d, 0x03,
+    0xaf, 0xdc, 0x98, 0x25, 0xfb, 0xa5, 0x8a, 0x3a, 0x5f, 0x83, 0x25, 0xfd, 0xaf, 0xe5, 0x7d, 0xa4,
+    0x8b, 0x3b, 0x11, 0x1b, 0xd6, 0x0f, 0x28, 0x4f, 0xaf, 0xdd, 0x25, 0x0e, 0x81, 0xa7, 0x7c, 0x8d,
+    0x09, 0xc3, 0xe7, 0x92, 0x05, 0xff, 0x01, 0x56, 0x46, 0xfd, 0x09, 0xde, 0x9c, 0x75, 0xfc, 0x20,
+    0x03, 0xe1, 0xc1, 0xb8, 0x96, 0x61, 0xec, 0x7d, 0x36, 0xb6, 0x75, 0x64, 0x12, 0x7d, 0x1b, 0x93,
+    0xbf, 0xa5, 0x6e, 0x92, 0x80, 0x1a, 0x77, 0xa1, 0x1f, 0x44, 0x61, 0x10, 0xe1, 0xa3, 0x36, 0xcb,
+    0x7c, 0x88, 0x6f, 0x24, 0xca, 0x96, 0x7d, 0x1b, 0xc9, 0x16, 0x28, 0xd9, 0x24, 0x10, 0xc8, 0xb6,
+    0xcb, 0x4d, 0x40, 0x9e, 0x6e, 0x81, 0x6e, 0x04, 0x44, 0x72, 0xf5, 0x1d, 0x0f, 0x25, 0x25, 0xdb,
+    0x36, 0x48, 0xac, 0x66, 0xd9, 0xb3, 0x75, 0xe0, 0xfb, 0x38, 0x2a, 0xec, 0x88, 0xeb, 0x5d, 0x11,
+    0x74, 0x44, 0x05, 0x85, 0xb5, 0x93, 0x34, 0x5e, 0xe2, 0x0f, 0xf1, 0x26, 0xd7, 0xbd, 0x72, 0x78,
+    0x37, 0x71, 0x14, 0x67, 0x09, 0x98, 0x59, 0x69, 0x4b, 0x8f, 0xd9, 0x2f, 0x86, 0x0a, 0x87, 0xda,
+    0xfb, 0xbc, 0x8c, 0x6f, 0xf3, 0xa3, 0x23, 0x16, 0xe3, 0x62, 0x15, 0x36, 0x20, 0x84, 0xfc, 0x65,
+    0x83, 0xfd, 0xc0, 0x45, 0x5d, 0x69, 0xf3, 0x4f, 0x7e, 0xfa, 0x31, 0xb9, 0xed, 0x01, 0xa2, 0xba,
+    0xfb, 0xed, 0xb4, 0x3f, 0xa4, 0x44, 0xbf, 0x75, 0xce, 0x07, 0xc2, 0x7d, 0x9d, 0x67, 0x5e, 0x1a,
+    0x24, 0x64, 0xd6, 0xb9, 0x76, 0x53, 0x24, 0x2b, 0xf4, 0x8c, 0x8d, 0x50, 0x0f, 0xca, 0xf8, 0xe4,
+    0x1f, 0x5d, 0x8f, 0x04, 0xd7, 0x2e, 0xc1, 0x1f, 0x30, 0x75, 0xa8, 0xb0, 0x49, 0xd2, 0x1c, 0xf0,
+    0x49, 0x9e, 0xf8, 0x7e, 0x8a, 0xb3, 0x4c, 0x1a, 0x0d, 0xc0, 0xe3, 0xa6, 0xd7, 0x6e, 0x38, 0xc7,
+    0x5e, 0x66, 0x21, 0x74, 0xe9, 0x66, 0x59, 0x70, 0x5d, 0xbb, 0xc4, 0x53, 0x97, 0x00, 0x89, 0x3b,
+    0xfb, 0x4a, 0xb5, 0x93, 0xcf, 0x02, 0xf7, 0x0a, 0x36, 0x82, 0x04, 0xca, 0xd2, 0x99, 0xbb, 0x49,
+    0x42, 0xac, 0xf1, 0xb3, 0x74, 0x89, 0xb7, 0x9e, 0xc3, 0x1e, 0x5b, 0x38, 0x79, 0x06, 0x11, 0x65,
+    0x09, 0xee, 0x55, 0x9a, 0xf2, 0xc5, 0xd0, 0x02, 0x6f, 0x12, 0xcb, 0xb0, 0xc9, 0x15, 0x1c, 0xe6,
+    0x79, 0x10, 0xe2, 0xc8, 0xd3, 0x17, 0x66, 0x76, 0x94, 0x5d, 0x80, 0xf5, 0xb8, 0xb0, 0x69, 0x29,
+    0x1f, 0x4c, 0x4b, 0xd9, 0xbd, 0xcf, 0x58, 0x59, 0x79, 0xf3, 0x07, 0x21, 0x2f, 0x41, 0x26, 0x6d,
+    0xe8, 0x12, 0xe0, 0xb5, 0xa1, 0x8f, 0xe0, 0xef, 0x75, 0x28, 0xd0, 0xf6, 0x0d, 0x18, 0xbc, 0x36,
+    0xbc, 0x88, 0x93, 0xc0, 0xd3, 0x44, 0x29, 0xc6, 0x2d, 0xb2, 0xe4, 0x53, 0x76, 0xfd, 0xd2, 0xe9,
+    0xf7, 0xb1, 0x3e, 0x72, 0x11, 0x62, 0x37, 0x9a, 0xc3, 0xa6, 0x04, 0x71, 0x24, 0x4d, 0x85, 0xf1,
+    0xd5, 0x07, 0x50, 0x1a, 0x88, 0x2a, 0x23, 0x10, 0xe0, 0x05, 0xa7, 0x2e, 0xd9, 0xa6, 0x60, 0x06,
+    0xe0, 0x47, 0xb7, 0x44, 0xc5, 0x62, 0xbb, 0x65, 0xda, 0xda, 0x66, 0x1b, 0x02, 0x2f, 0x6e, 0x46,
+    0x5e, 0x40, 0xb8, 0x4d, 0x6c, 0x13, 0x9a, 0x9a, 0x98, 0xf2, 0xd9, 0xe7, 0x0c, 0x4d, 0xd1, 0x6f,
+    0x9f, 0xe8, 0xc1, 0x8f, 0xfc, 0xf8, 0xa6, 0x1f, 0x47, 0x61, 0xec, 0xfa, 0x30, 0xd6, 0xed, 0xa1,
+    0xe9, 0x8c, 0x1e, 0x2e, 0x1a, 0xfb, 0xe1, 0x0c, 0xe2, 0x97, 0x90, 0x65, 0xbc, 0x5b, 0xfe, 0x8e,
+    0x3d, 0x92, 0x75, 0x7b, 0x67, 0x1d, 0x0a, 0xf6, 0x24, 0xf2, 0x7f, 0x0d, 0x42, 0xb0, 0x70, 0x42,
+    0xb7, 0x8c, 0x0d, 0xcb, 0x07, 0xa9, 0x0f, 0xee, 0xec, 0xf9, 0x35, 0xa4, 0x1d, 0xaf, 0x83, 0x0c,
+    0xb2, 0x0f, 0x9c, 0x76, 0x1d, 0x0f, 0xc2, 0xcc, 0x67, 0x88, 0xce, 0x39, 0xf5, 0x4c, 0xa0, 0x82,
+    0xb0, 0xc0, 0x29, 0x2c, 0xcb, 0x5c, 0x84, 0x4c, 0x30, 0x58, 0xa1, 0xee, 0x03, 0x15, 0x0c, 0xdc,
+    0x9f, 0xe7, 0x81, 0x02, 0x7a, 0xcc, 0x85, 0x30, 0xb6, 0x21, 0x71, 0x49, 0x49, 0x57, 0x03, 0xdb,
+    0x00, 0x8c, 0x7b, 0x85, 0x81, 0xc8, 0x37, 0x84, 0xc3, 0x0c, 0x03, 0xf8, 0xed, 0x3a, 0x85, 0x45,
+    0x22, 0x7c, 0x83, 0xfe, 0xfe, 0xe6, 0xf5, 0x4b, 0x42, 0x92, 0x0f, 0xf8, 0x8f, 0x2d, 0xce, 0x08,
+    0x5d, 0x09, 0xe6, 0xfa, 0x71, 0x82, 0xa3, 0xae, 0x73, 0xf9, 0x6e, 0xbe, 0xa0, 0x19, 0xc5, 0x20,
+    0x27, 0x08, 0x1f, 0x48, 0xba, 0xc5, 0x02, 0x08, 0x46, 0x05, 0xda, 0x4b, 0xd8, 0x41, 0x2a, 0xd6,
+    0x05, 0x4f, 0xaf, 0x8e, 0x16, 0x77, 0x09, 0x4b, 0x45, 0x20, 0x70, 0x80, 0xa0, 0x2e, 0xdd, 0xbc,
+    0xc1, 0xef, 0x59, 0x1c, 0x39, 0x39, 0xf9, 0x28, 0x05, 0x8c, 0xbb, 0x8c, 0xc0, 0xe1, 0xf2, 0xd6,
+    0x6e, 0x74, 0x85, 0x81, 0x9b, 0xd5, 0x36, 0xf2, 0x28, 0x64, 0x97, 0xca, 0x43, 0xc5, 0xa5, 0x90,
+    0x0c, 0x6e, 0x4e, 0xe1, 0xd0, 0x74, 0x3a, 0x45, 0xc7, 0xf2, 0x1c, 0x45, 0xdf, 0x66, 0x6c, 0x7c,
+    0x3c, 0x1c, 0xaa, 0x58, 0x59, 0x12, 0x47, 0x19, 0x5e, 0x40, 0xd0, 0x66, 0xf3, 0x0e, 0xa8, 0x82,
+    0xb8, 0xec, 0x44, 0x3d, 0x70, 0x0c, 0x7d, 0x39, 0xb9, 0xa2, 0xd1, 0x36, 0xf1, 0x61, 0x29, 0x1f,
+    0x09, 0xcd, 0xae, 0xb6, 0x61, 0x78, 0xf7, 0x00, 0x3d, 0x9f, 0x5f, 0xa2, 0x20, 0x43, 0x57, 0x31,
+    0x8d, 0x82, 0x24, 0x86, 0xd3, 0xc9, 0x88, 0xf5, 0xfb, 0x7d, 0x47, 0x56, 0xea, 0x2e, 0x34, 0x19,
+    0x22, 0x18, 0x0f, 0x57, 0x4e, 0x7f, 0x9d, 0xe2, 0x15, 0xa8, 0xc0, 0x19, 0x38, 0xd5, 0xf4, 0x68,
+    0xfa, 0xb9, 0xa6, 0x1c, 0xdc, 0x80, 0x8a, 0xd1, 0x4d, 0x1a, 0x33, 0x59, 0xb8, 0x37, 0xff, 0x96,
+    0xef, 0x48, 0xe4, 0x77, 0xff, 0x3a, 0x7f, 0xf7, 0x16, 0x74, 0x93, 0x02, 0x68, 0xb0, 0xba, 0xd3,
+    0x8d, 0x21, 0xff, 0xd8, 0xe3, 0x98, 0xf4, 0x6f, 0x08, 0x70, 0x42, 0xf5, 0xba, 0xd9, 0x01, 0x13,
+    0x6c, 0xa4, 0x30, 0xcb, 0x2f, 0x00, 0x2c, 0x8d, 0x14, 0xd4, 0x6c, 0x53, 0x5c, 0x5c, 0xba, 0xb1,
+    0x2e, 0xc8, 0xa3, 0x4e, 0x0a, 0x93, 0xa4, 0x22, 0x83, 0xc4, 0x34, 0xc6, 0x88, 0x45, 0xa9, 0x55,
+    0xe6, 0x11, 0xa7, 0x0f, 0x51, 0x63, 0x0b, 0x88, 0x46, 0x40, 0x28, 0x61, 0xed, 0xe1, 0x88, 0x07,
+    0x58, 0x0c, 0xb9, 0x97, 0x14, 0x0b, 0x4a, 0x24, 0x3d, 0x4e, 0xe5, 0xeb, 0xc8, 0x91, 0xaa, 0x84,
+    0x36, 0xe2, 0x97, 0xce, 0x96, 0x88, 0x60, 0x26, 0x53, 0x72, 0x68, 0x2b, 0x59, 0xca, 0x67, 0x85,
+    0x5b, 0x6d, 0x23, 0x94, 0xec, 0x81, 0xad, 0xb2, 0x09, 0x00, 0xab, 0x88, 0x0a, 0xb2, 0x60, 0xbd,
+    0x8c, 0x80, 0x25, 0x8a, 0x16, 0x15, 0x73, 0xd0, 0x22, 0x2e, 0x96, 0x90, 0x6a, 0xa8, 0xd4, 0xd5,
+    0x91, 0x07, 0x4b, 0x53, 0x1e, 0x25, 0x8c, 0x96, 0x72, 0xc8, 0xa1, 0xb4, 0x44, 0x32, 0x02, 0x6c,
+    0xbe, 0x8e, 0x16, 0x62, 0x4d, 0x0c, 0x9b, 0xc0, 0x6a, 0xf4, 0x2d, 0x71, 0x2c, 0x51, 0x39, 0x47,
+    0xd1, 0x43, 0x70, 0x89, 0x94, 0xb8, 0x69, 0x06, 0xb2, 0x93, 0xae, 0x35, 0x4a, 0x73, 0xfc, 0x87,
+    0x90, 0xb6, 0xc2, 0xd9, 0xca, 0x83, 0xb5, 0xb4, 0xa2, 0x1c, 0xbe, 0x0b, 0xf6, 0x44, 0x00, 0x57,
+    0xc1, 0x8a, 0x58, 0x25, 0x83, 0x15, 0xa1, 0x5a, 0x85, 0x55, 0x23, 0xb8, 0xb2, 0x79, 0x86, 0xfd,
+    0x1b, 0xc1, 0xb3, 0xa0, 0xaf, 0x84, 0x4f, 0x69, 0x01, 0x33, 0xac, 0x1a, 0x28, 0x1a, 0xfb, 0x46,
+    0xbc, 0xcd, 0x11, 0xb6, 0x19, 0xbe, 0xdc, 0x52, 0x57, 0x52, 0xa9, 0xdf, 0x29, 0x4d, 0x51, 0x01,
+    0xec, 0x0d, 0x88, 0x55, 0x0f, 0x37, 0x62, 0x70, 0x4f, 0xa9, 0x38, 0xf5, 0x80, 0x63, 0xf4, 0xf5,
+    0x6b, 0xdd, 0xfc, 0x84, 0xc7, 0x57, 0xc9, 0x0f, 0xf5, 0xc1, 0x28, 0xae, 0xc8, 0x9a, 0x71, 0xa3,
+    0xb9, 0x41, 0xd9, 0x79, 0xfd, 0x1a, 0xe0, 0xd0, 0x47, 0x3f, 0xbc, 0x05, 0xc4, 0x1f, 0x40, 0xe8,
+    0x8c, 0xa0, 0x28, 0x26, 0x68, 0x89, 0x11, 0xec, 0x04, 0x01, 0x2f, 0x5f, 0x78, 0x73, 0x4a, 0x5e,
+    0x88, 0xfe, 0xfd, 0xf7, 0xa8, 0xd2, 0xa3, 0xc1, 0x9c, 0xe9, 0xb2, 0x76, 0xe3, 0x45, 0xe0, 0xa2,
+    0x45, 0x99, 0x42, 0xed, 0xc3, 0x5a, 0x95, 0x7b, 0x52, 0x39, 0x54, 0x0f, 0xe1, 0x7e, 0x8c, 0x0a,
+    0x1a, 0xad, 0x98, 0xe4, 0x7b, 0xdd, 0xa0, 0x41, 0x8b, 0xd5, 0xef, 0xc6, 0x19, 0x5f, 0xc5, 0xe5,
+    0x14, 0x9a, 0xf9, 0x7a, 0x30, 0xf8, 0xd7, 0xb8, 0x3b, 0xfe, 0xed, 0xf8, 0xe8, 0xf1, 0xa7, 0xaf,
+    0x93, 0xdf, 0x86, 0xf0, 0xa3, 0xd7, 0xfd, 0x67, 0xbf, 0x3b, 0x3e, 0x81, 0x7f, 0x9f, 0x7c, 0xfa,
+    0x3a, 0x86, 0x1f, 0xc7, 0x9f, 0xd8, 0xf8, 0xd7, 0xd1, 0xcf, 0xec, 0x27, 0xff, 0xbb, 0xd7, 0xfb,
+    0x32, 0xf9, 0xf6, 0xe7, 0x41, 0x9f, 0xd0, 0xc4, 0xcb, 0x7a, 0xf6, 0x7a, 0xcd, 0xbc, 0xbe, 0xc9,
+    0xf1, 0x10, 0xbd, 0x62, 0x4a, 0x04, 0xb7, 0xc0, 0xa9, 0x1b, 0xe5, 0x12, 0xa0, 0x55, 0x1a, 0x6f,
+    0xd0, 0x78, 0x7c, 0xdc, 0x1f, 0xd2, 0xdf, 0x34, 0x83, 0x19, 0x4f, 0x1e, 0xf7, 0xc7, 0x27, 0x27,
+    0xf9, 0x1f, 0x4d, 0x20, 0xfb, 0xa9, 0x7e, 0x30, 0x95, 0x5c, 0x9f, 0x0d, 0x82, 0xf9, 0xbc, 0x3e,
+    0x89, 0xe7, 0x2c, 0xf7, 0x80, 0xec, 0xe1, 0xeb, 0xd7, 0x4e, 0x33, 0x02, 0x3a, 0x47, 0xa3, 0x96,
+    0x90, 0x33, 0xf4, 0xe3, 0xc9, 0xc9, 0xe4, 0xa4, 0xb3, 0x8b, 0x56, 0xa8, 0x79, 0x48, 0x4a, 0x41,
+    0xd1, 0x76, 0xb3, 0xc4, 0x29, 0x57, 0xc9, 0x88, 0xaa, 0x82, 0x91, 0xd4, 0x15, 0x50, 0x63, 0x5e,
+    0x9d, 0xae, 0x25, 0x4f, 0x90, 0xed, 0x8b, 0xfa, 0x1a, 0x5b, 0x2a, 0xa1, 0xe8, 0xcf, 0x02, 0xa0,
+    0xab, 0xaf, 0xd7, 0x42, 0xce, 0x57, 0x82, 0x0c, 0xca, 0x80, 0x4e, 0xb3, 0xa5, 0x1a, 0x71, 0x5f,
+    0xe7, 0xdb, 0x4c, 0x0c, 0x14, 0xae, 0x8d, 0x69, 0x83, 0xe7, 0x46, 0x8e, 0xe7, 0x8c, 0x44, 0xa1,
+    0x20, 0x99, 0x71, 0x69, 0x7f, 0xf4, 0xfd, 0xd0, 0xb3, 0x10, 0x8d, 0x6f, 0x33, 0x4b, 0x51, 0xd8,
+    0xd6, 0x67, 0x6b, 0x0d, 0xd5, 0x0a, 0x4c, 0x8d, 0xb4, 0xd3, 0xd6, 0x71, 0xd0, 0x9b, 0x22, 0x8b,
+    0xc9, 0x5d, 0x41, 0x2d, 0x03, 0x42, 0x23, 0x02, 0x05, 0x0f, 0x1a, 0x6a, 0x12, 0x56, 0x65, 0x4f,
+    0xe0, 0xce, 0xba, 0x96, 0x04, 0xc9, 0xb0, 0xb7, 0xec, 0xad, 0xfb, 0xd6, 0x06, 0xd8, 0x6b, 0xb1,
+    0x25, 0x0b, 0xa8, 0x3e, 0x32, 0x7a, 0x1f, 0x2a, 0x97, 0xdd, 0x8d, 0x7b, 0xd2, 0x86, 0xe3, 0xea,
+    0xf0, 0x60, 0x32, 0xad, 0xc2, 0xee, 0xc6, 0xf7, 0x92, 0xe3, 0xa2, 0xef, 0x9a, 0x2d, 0xa9, 0x9a,
+    0xed, 0x4e, 0xd7, 0x9a, 0x25, 0xea, 0x5c, 0xdb, 0x53, 0x49, 0xd5, 0x39, 0xda, 0x40, 0xf6, 0x39,
+    0xde, 0x6f, 0xdc, 0x5b, 0xb0, 0x26, 0x46, 0xa9, 0xdd, 0x41, 0xc9, 0xd3, 0x26, 0xd8, 0x04, 0x2d,
+    0xf5, 0xdc, 0x2d, 0x02, 0xbe, 0x79, 0xbf, 0x58, 0xa0, 0x35, 0x60, 0xb7, 0x8a, 0xca, 0xf9, 0x92,
+    0x5d, 0x2d, 0x8f, 0x35, 0x54, 0xa7, 0xa5, 0xb9, 0xaa, 0xd2, 0xd4, 0x49, 0x43, 0x5d, 0x2d, 0x99,
+    0xb6, 0xfb, 0xfb, 0x7a, 0x35, 0xe9, 0x39, 0xf5, 0x6e, 0xba, 0x62, 0xd8, 0xed, 0xd3, 0xad, 0x2f,
+    0x15, 0x55, 0x32, 0xbd, 0x58, 0xb1, 0x17, 0xd7, 0x7d, 0x9a, 0x97, 0x8a, 0xc2, 0x58, 0x70, 0x58,
+    0x01, 0x28, 0x85, 0x2d, 0x5b, 0x1d, 0x59, 0x8f, 0x2c, 0xa5, 0x75, 0x6a, 0x05, 0x59, 0x8f, 0x26,
+    0x47, 0x32, 0xad, 0x5c, 0xae, 0x47, 0x4c, 0x78, 0x79, 0x6c, 0x16, 0xcc, 0xad, 0x65, 0x04, 0x97,
+    0x21, 0x61, 0x57, 0x64, 0xac, 0xcd, 0xd2, 0x72, 0x32, 0x95, 0x59, 0x6d, 0x33, 0x01, 0x7a, 0x0d,
+    0xaa, 0x52, 0xd0, 0x2f, 0x46, 0xf3, 0xea, 0xc7, 0x4a, 0xa9, 0x8c, 0xaa, 0xa8, 0x31, 0xd6, 0x56,
+    0x90, 0x28, 0x82, 0x16, 0x6a, 0x0a, 0x7b, 0x15, 0x04, 0x72, 0x2f, 0x6c, 0x29, 0xd7, 0xeb, 0xd5,
+    0x20, 0xc7, 0x9c, 0x7c, 0xf1, 0x5f, 0xc3, 0xd8, 0x25, 0xd6, 0x68, 0xd4, 0x40, 0x84, 0xef, 0x84,
+    0x85, 0x86, 0x16, 0x1c, 0x2a, 0xc8, 0xa8, 0x7e, 0x17, 0xb5, 0xf2, 0xc8, 0x95, 0x0a, 0x65, 0x35,
+    0x62, 0x75, 0x59, 0x59, 0xc5, 0x82, 0xf0, 0xba, 0x52, 0xa5, 0xdf, 0x8c, 0x40, 0xdd, 0x1e, 0x6a,
+    0x70, 0x85, 0xd4, 0x7f, 0x8e, 0x1e, 0x3d, 0x9a, 0xd4, 0x90, 0xa1, 0xf7, 0xfd, 0x62, 0xdd, 0xe2,
+    0xea, 0xbf, 0xd6, 0xf0, 0xe4, 0x17, 0x81, 0xfc, 0xce, 0x41, 0x7e, 0x20, 0x68, 0x44, 0x2e, 0x1c,
+    0xa7, 0x7e, 0x0b, 0xd1, 0x2c, 0x73, 0xfe, 0xb4, 0x20, 0x63, 0xda, 0x6e, 0x6e, 0xea, 0x09, 0x88,
+    0x93, 0x57, 0xf9, 0x20, 0xd1, 0x48, 0xe5, 0x7d, 0x9c, 0xe9, 0x9a, 0xcf, 0x9f, 0x2e, 0x94, 0x8b,
+    0x9c, 0x4a, 0x02, 0xec, 0x59, 0x43, 0xb0, 0x60, 0x3c, 0x71, 0x94, 0x97, 0x5c, 0x56, 0x7c, 0xe9,
+    0xed, 0x03, 0x28, 0xe8, 0x2f, 0x21, 0x0d, 0xc8, 0x69, 0xf1, 0x2e, 0x22, 0x0b, 0x50, 0xfd, 0x70,
+    0xd2, 0x2c, 0x8e, 0x5c, 0x37, 0x6b, 0xd7, 0x44, 0x0d, 0xfb, 0xa9, 0xd4, 0xae, 0xc6, 0x85, 0x51,
+    0x4b, 0x64, 0xe3, 0x14, 0x54, 0xd5, 0x81, 0x55, 0xf1, 0x84, 0x3d, 0xa4, 0x51, 0x0a, 0xe5, 0xa3,
+    0x0e, 0xb8, 0x84, 0xa4, 0x5b, 0x7e, 0xa6, 0x8f, 0x2d, 0xdd, 0x2f, 0x9d, 0x94, 0xbe, 0x83, 0x96,
+    0xa3, 0x7d, 0xf8, 0xfc, 0x90, 0x5d, 0x42, 0x2b, 0xa3, 0xda, 0x3d, 0xf4, 0xc3, 0x8e, 0x28, 0xa7,
+    0x15, 0x20, 0xd7, 0xb8, 0x46, 0xeb, 0x7c, 0xe3, 0x57, 0xeb, 0x29, 0x86, 0x4d, 0x10, 0x37, 0xea,
+    0x9c, 0x55, 0x3a, 0x5a, 0xdc, 0xb4, 0xdb, 0xdf, 0x93, 0xe8, 0x53, 0x90, 0xfc, 0xa6, 0x3d, 0x45,
+    0x7e, 0xec, 0x6d, 0x37, 0x38, 0x22, 0xfd, 0x2b, 0x4c, 0x9e, 0x87, 0x98, 0xfe, 0xf3, 0xe9, 0xdd,
+    0x2b, 0xbf, 0xeb, 0xc8, 0x70, 0xf4, 0x19, 0xa0, 0x60, 0xb7, 0x0e, 0xa9, 0x00, 0xa2, 0x18, 0xf6,
+    0xcb, 0xf3, 0x3a, 0x74, 0x3b, 0x06, 0xa5, 0xa5, 0xdf, 0xa9, 0xd7, 0x51, 0xd1, 0x61, 0x29, 0xbe,
+    0x71, 0xcb, 0x5e, 0x47, 0xc0, 0x00, 0x96, 0xa5, 0x91, 0x6f, 0xdd, 0xdb, 0xc8, 0x22, 0xc3, 0x5b,
+    0xb5, 0x22, 0x7b, 0xa5, 0x9d, 0x94, 0x23, 0x23, 0x6a, 0x3a, 0x6a, 0x4b, 0xb3, 0x02, 0x45, 0xa3,
+    0xa6, 0x7b, 0xbd, 0x96, 0x14, 0x75, 0x34, 0x4a, 0x55, 0x7b, 0x05, 0xa8, 0x35, 0x40, 0x15, 0x94,
+    0x62, 0xab, 0x2f, 0x03, 0x75, 0xc8, 0x2a, 0xa4, 0xac, 0x77, 0xe5, 0x95, 0xa0, 0x8d, 0xbe, 0x15,
+    0x04, 0x4a, 0xc9, 0x78, 0x3a, 0xa8, 0xa3, 0x62, 0x00, 0xcb, 0x14, 0xda, 0x6e, 0x93, 0x0d, 0x9e,
+    0xd2, 0xb1, 0x3c, 0x2f, 0xd4, 0x91, 0xb1, 0x80, 0x53, 0x2a, 0x5a, 0x87, 0x40, 0x1d, 0x05, 0x0d,
+    0x94, 0x62, 0x5b, 0x1f, 0x29, 0xea, 0x68, 0x58, 0x11, 0x1c, 0xe9, 0x31, 0xa3, 0x59, 0x0e, 0x19,
+    0x30, 0xc7, 0x2c, 0x5e, 0x02, 0x9a, 0x30, 0x0b, 0xc0, 0x1c, 0xb3, 0x48, 0x66, 0x9a, 0x30, 0x0b,
+    0xc0, 0x62, 0x4d, 0x39, 0x9b, 0x69, 0x5c, 0x57, 0x06, 0xce, 0x29, 0xa8, 0xef, 0x2a, 0x4d, 0x24,
+    0x54, 0x68, 0x85, 0x46, 0x5b, 0x53, 0xb2, 0x22, 0x28, 0x94, 0x76, 0x39, 0xed, 0x95, 0x48, 0x39,
+    0xc5, 0x3c, 0xd9, 0x69, 0x22, 0x92, 0xc3, 0xe5, 0x78, 0x46, 0xaa, 0xd3, 0x44, 0xc0, 0x40, 0x70,
+    0x58, 0xf3, 0x84, 0x9a, 0xf2, 0xd4, 0x11, 0xd1, 0x61, 0x29, 0x7e, 0x75, 0xb6, 0x53, 0x47, 0xa9,
+    0x1a, 0xab, 0xf0, 0x61, 0x6d, 0x43, 0x99, 0x01, 0xcc, 0xf4, 0x63, 0x3e, 0x97, 0xd5, 0x6a, 0xc7,
+    0x04, 0x57, 0xa8, 0xb4, 0x3b, 0x38, 0x06, 0x34, 0x6f, 0x0d, 0x28, 0xf2, 0x8d, 0x55, 0x10, 0x86,
+    0x97, 0xcc, 0x3b, 0xf0, 0x7c, 0x88, 0x75, 0x8d, 0x68, 0xee, 0x02, 0x6a, 0x79, 0xf8, 0xfb, 0xe5,
+    0xe2, 0xcd, 0x6b, 0xf1, 0x30, 0x6f, 0xb6, 0xc7, 0x70, 0x8c, 0xfe, 0x2a, 0x4e, 0x9f, 0xbb, 0xde,
+    0xba, 0xcb, 0x69, 0xd1, 0xd6, 0x59, 0x1f, 0xdf, 0x8a, 0x5e, 0x16, 0xd6, 0xbf, 0x14, 0xdf, 0xc8,
+    0xdc, 0x7a, 0xec, 0xea, 0x53, 0x30, 0x0c, 0xee, 0x32, 0xb8, 0x66, 0x9e, 0x29, 0xbe, 0xe9, 0x7b,
+    0x21, 0x9c, 0xba, 0xb7, 0xfc, 0x7e, 0xc3, 0xc9, 0xfb, 0x01, 0x1d, 0xd1, 0x04, 0x95, 0x37, 0xd7,
+    0x55, 0x53, 0xca, 0x12, 0x37, 0xe2, 0xa4, 0x38, 0xa8, 0x85, 0x1e, 0x27, 0xa1, 0x74, 0xeb, 0x39,
+    0x12, 0x02, 0x13, 0x99, 0xf7, 0x89, 0x70, 0x20, 0x9a, 0x0d, 0x6a, 0xad, 0x6f, 0x35, 0x0c, 0x04,
+    0xb9, 0xaa, 0xcb, 0x6c, 0x91, 0xdc, 0x25, 0x6c, 0x75, 0xda, 0x31, 0xea, 0xc8, 0x13, 0x0a, 0x6f,
+    0x6a, 0x3f, 0xa9, 0x02, 0xc7, 0xd2, 0xc8, 0x82, 0x1d, 0x3a, 0x7e, 0xd6, 0x19, 0x0c, 0xd0, 0x62,
+    0x8d, 0x61, 0x17, 0x53, 0xfa, 0xa6, 0x41, 0x27, 0x44, 0x61, 0x9a, 0xd1, 0x37, 0x0c, 0xeb, 0xa3,
+    0x1f, 0x6f, 0x61, 0xab, 0x30, 0xe4, 0x2a, 0x31, 0x94, 0x7c, 0x56, 0x93, 0x44, 0x99, 0xb3, 0x0b,
+    0xa3, 0x43, 0xa9, 0xa2, 0x88, 0x29, 0x0d, 0xc6, 0x0f, 0x32, 0x77, 0x19, 0x62, 0x9f, 0x5d, 0x1e,
+    0x81, 0x19, 0x89, 0x17, 0x60, 0x05, 0x46, 0x6e, 0xd9, 0x95, 0xc1, 0xd0, 0xcf, 0xc8, 0xc9, 0x30,
+    0xb6, 0x2b, 0xc0, 0x41, 0xa7, 0xc8, 0xc1, 0xfd, 0xab, 0x3e, 0x5a, 0x13, 0x92, 0x9c, 0x0e, 0x06,
+    0xb4, 0xab, 0x69, 0xed, 0x2e, 0x07, 0x6e, 0x12, 0x0c, 0x02, 0xf0, 0x02, 0xd9, 0x80, 0xf1, 0x35,
+    0x60, 0x7d, 0x48, 0x0e, 0x37, 0x48, 0x37, 0x01, 0x20, 0xff, 0x62, 0x1d, 0x84, 0x7e, 0x37, 0x37,
+    0x92, 0x9e, 0x39, 0x55, 0xec, 0x96, 0x65, 0x4e, 0xe6, 0xdc, 0x0c, 0xdf, 0xda, 0x0a, 0x37, 0x3d,
+    0xe5, 0x98, 0xf5, 0x93, 0x6d, 0xb6, 0xee, 0x7e, 0x41, 0x65, 0x89, 0xc2, 0xaa, 0x93, 0xd2, 0x16,
+    0x4f, 0xcb, 0x7f, 0x3e, 0x54, 0x76, 0xf7, 0x54, 0xdd, 0x6b, 0xd6, 0xd9, 0xa3, 0xba, 0x00, 0x6b,
+    0xab, 0x5a, 0xeb, 0x66, 0xb0, 0x17, 0xcf, 0xff, 0xbf, 0x7a, 0xc1, 0x72, 0x3e, 0x79, 0x6d, 0x05,
+    0x34, 0x59, 0x5f, 0x14, 0xab, 0x2e, 0x8d, 0x1e, 0xb1, 0x9e, 0xed, 0xf8, 0xa9, 0x04, 0xc4, 0x39,
+    0xac, 0x6f, 0x38, 0x32, 0xb1, 0x24, 0x78, 0xb3, 0x48, 0xaa, 0x5a, 0x4a, 0x82, 0xb3, 0x54, 0x46,
+    0x55, 0x58, 0x32, 0xa0, 0xbd, 0x1c, 0xaa, 0x66, 0x53, 0xdc, 0xc5, 0x36, 0x54, 0x3f, 0xad, 0xc4,
+    0x04, 0x84, 0xca, 0x52, 0xa7, 0x85, 0xc0, 0x3a, 0xba, 0xfd, 0x46, 0xa7, 0x96, 0x04, 0x45, 0x31,
+    0x2a, 0x99, 0x2a, 0xbc, 0x12, 0x4c, 0x2f, 0x5f, 0xaa, 0x30, 0x0a, 0xa8, 0x8a, 0x9a, 0xa5, 0x5a,
+    0x4b, 0x79, 0x99, 0x60, 0x29, 0x51, 0xaa, 0x16, 0x93, 0x01, 0xed, 0x75, 0x49, 0x13, 0x26, 0x53,
+    0x68, 0x65, 0x9f, 0x93, 0x89, 0xa7, 0x82, 0x56, 0xd4, 0x0f, 0xd5, 0xba, 0x61, 0x30, 0x5a, 0xad,
+    0x50, 0xb9, 0x94, 0x00, 0xd2, 0x0a, 0x84, 0x3a, 0x70, 0x0a, 0xa4, 0x55, 0x05, 0x75, 0xe0, 0x14,
+    0xc8, 0x52, 0x0a, 0xd4, 0xae, 0x20, 0x00, 0x6d, 0xf9, 0x7f, 0x1d, 0x5e, 0x01, 0x59, 0x91, 0xf4,
+    0x37, 0xe2, 0xf2, 0x8d, 0xaa, 0xbf, 0xc9, 0xac, 0x41, 0xe7, 0x56, 0x6f, 0x5e, 0x60, 0xda, 0x51,
+    0x00, 0xa6, 0x22, 0x91, 0xaf, 0x36, 0xdf, 0x02, 0xdc, 0x4c, 0xdc, 0xab, 0x91, 0x24, 0xc8, 0xba,
+    0x7c, 0xbd, 0x8a, 0xd7, 0xf2, 0x96, 0xd3, 0x92, 0x99, 0xd7, 0x9e, 0xd0, 0xc2, 0x81, 0x56, 0x76,
+    0xaf, 0x59, 0x24, 0x54, 0x40, 0x6d, 0x39, 0x78, 0x23, 0x26, 0x37, 0x50, 0x29, 0xdb, 0xd6, 0x3d,
+    0x2d, 0x4f, 0xbe, 0x59, 0x46, 0x97, 0xbf, 0x83, 0xb2, 0x2f, 0x94, 0xe5, 0xed, 0xbe, 0x45, 0x8a,
+    0xc6, 0x46, 0x69, 0x76, 0x25, 0x7d, 0xf9, 0xec, 0xc8, 0x41, 0x7f, 0xb1, 0x07, 0xa6, 0x8a, 0xae,
+    0xe1, 0x8b, 0x78, 0x1b, 0xfa, 0xec, 0x29, 0x32, 0xc5, 0x24, 0x0d, 0xf0, 0x35, 0x2e, 0xd0, 0xad,
+    0xcd, 0xc3, 0xd1, 0x36, 0x0c, 0xd9, 0xf0, 0xf9, 0x20, 0xff, 0x5e, 0xc8, 0xf9, 0x40, 0x7c, 0xa3,
+    0x8e, 0x7e, 0xd1, 0x8d, 0x7e, 0xbf, 0x6e, 0x84, 0xd8, 0x57, 0x47, 0xa6, 0x8e, 0xf4, 0xbd, 0x98,
+    0x09, 0xde, 0x38, 0xb3, 0x3c, 0xab, 0x00, 0x8c, 0x11, 0x05, 0x4c, 0xd9, 0x37, 0xe8, 0x20, 0xdb,
+    0x47, 0x2c, 0x5b, 0x9c, 0x96, 0x09, 0x3e, 0x9d, 0x1d, 0xcf, 0x5e, 0xd0, 0x66, 0x78, 0x37, 0x04,
+    0xf0, 0x31, 0x5d, 0x06, 0x00, 0xab, 0xc1, 0x69, 0xa6, 0xaf, 0x8c, 0xf3, 0x4c, 0x7e, 0xc6, 0x52,
+    0x50, 0x60, 0x16, 0xa6, 0x01, 0x8a, 0xcd, 0x20, 0x9a, 0xb7, 0x4e, 0x79, 0xd6, 0x9a, 0xa3, 0x94,
+    0x19, 0x2a, 0x0a, 0xfc, 0xa9, 0x74, 0x0f, 0xca, 0x58, 0xac, 0x5f, 0x1a, 0xb8, 0x2b, 0xc2, 0xe1,
+    0x01, 0xbc, 0x4a, 0x5f, 0xa5, 0x72, 0x66, 0x4f, 0x44, 0xe4, 0xd0, 0x38, 0x17, 0x48, 0xca, 0x17,
+    0x84, 0x1c, 0x21, 0x4f, 0x3e, 0xc8, 0x25, 0xa8, 0xb8, 0x8a, 0x6d, 0x21, 0x4e, 0x95, 0x26, 0x85,
+    0x7f, 0x2f, 0x38, 0xca, 0x70, 0x48, 0x13, 0x27, 0xba, 0x98, 0xfd, 0x4a, 0x08, 0x60, 0xe2, 0x84,
+    0x65, 0x96, 0xec, 0x50, 0x4c, 0x9d, 0xa1, 0x33, 0x7b, 0xb9, 0x58, 0x5c, 0xa2, 0xcb, 0x8f, 0x8b,
+    0xf3, 0x01, 0x9f, 0x32, 0x60, 0x46, 0xce, 0x8c, 0xbe, 0xd3, 0x57, 0xce, 0x8f, 0x9d, 0xd9, 0xab,
+    0x68, 0x15, 0x6e, 0x6f, 0x9f, 0x3d, 0x45, 0xf4, 0x5b, 0x4c, 0x34, 0x09, 0x26, 0xb1, 0x17, 0x87,
+    0x95, 0x18, 0x13, 0x67, 0x46, 0x53, 0x3b, 0xe4, 0xa6, 0xa9, 0x7b, 0x57, 0x09, 0x75, 0xec, 0xcc,
+    0x3e, 0x3e, 0xbb, 0x2c, 0x5f, 0x26, 0x24, 0xc0, 0x01, 0x97, 0xf4, 0x00, 0xc5, 0x49, 0xed, 0x82,
+    0xea, 0x86, 0x76, 0x24, 0x53, 0xec, 0x18, 0xa6, 0xd8, 0xa1, 0xba, 0x35, 0xaf, 0x10, 0x3a, 0x52,
+    0xb5, 0x33, 0x55, 0x0a, 0x98, 0x80, 0x69, 0xc6, 0x5f, 0x9e, 0x3e, 0x1a, 0x3e, 0xfa, 0x71, 0x70,
+    0x93, 0x42, 0x11, 0xf3, 0xb3, 0xbf, 0x9c, 0x92, 0xd2, 0x41, 0x64, 0x4e, 0x67, 0x7f, 0x0b, 0xd0,
+    0x7a, 0x09, 0x77, 0x38, 0x55, 0xbc, 0x88, 0x65, 0xb6, 0x62, 0xbb, 0xce, 0x40, 0x8a, 0x44, 0x79,
+    0xf3, 0xe1, 0xf1, 0x18, 0xfe, 0x3b, 0xc4, 0x62, 0xd5, 0x2e, 0xbf, 0x03, 0xd9, 0x2d, 0x2f, 0x4e,
+    0x54, 0x6e, 0x8f, 0xc7, 0x87, 0x31, 0x69, 0xa9, 0x4c, 0x77, 0xb6, 0x11, 0xe3, 0xc5, 0xa4, 0xda,
+    0x44, 0xcc, 0x1a, 0x57, 0x0a, 0xba, 0xa2, 0xd2, 0x3d, 0xc0, 0x44, 0x94, 0x86, 0xc3, 0xfd, 0x34,
+    0x6e, 0xbe, 0xde, 0xec, 0xad, 0x5d, 0xc5, 0xa5, 0x8a, 0x64, 0xab, 0x7c, 0xb0, 0xbf, 0x3f, 0xdf,
+    0xaa, 0xdc, 0xc5, 0xde, 0x83, 0x2d, 0x08, 0x7a, 0x87, 0xd8, 0x81, 0xc2, 0xd2, 0x2e, 0xe6, 0x00,
+    0x61, 0x3e, 0x8b, 0xd3, 0x7f, 0x8b, 0x96, 0xb9, 0xc3, 0x2d, 0x22, 0x97, 0x49, 0x4a, 0x58, 0x0f,
+    0x91, 0xcb, 0xb8, 0xa8, 0x56, 0x65, 0xe3, 0x4e, 0x9b, 0x7e, 0xa3, 0xbd, 0x95, 0x94, 0x7e, 0x49,
+    0xed, 0x50, 0x49, 0x15, 0x5b, 0x13, 0x55, 0xf5, 0xc1, 0x16, 0xa6, 0x3c, 0x3e, 0x1e, 0x60, 0x58,
+    0xb6, 0xae, 0xda, 0xfd, 0x4e, 0xa7, 0xfe, 0xaa, 0xa7, 0x3a, 0xc3, 0x21, 0xe4, 0xa3, 0xf1, 0x6a,
+    0x75, 0x58, 0x9a, 0x91, 0xf7, 0xc8, 0xee, 0xc7, 0xa0, 0xf6, 0x72, 0x78, 0x3f, 0xbe, 0xe3, 0x5d,
+    0x14, 0xde, 0x21, 0xf6, 0xfd, 0x37, 0x7a, 0x01, 0x75, 0xf0, 0xb6, 0xaa, 0x4f, 0x92, 0x07, 0x28,
+    0xcb, 0xda, 0x9a, 0xbb, 0x9f, 0xde, 0xcc, 0x87, 0x4e, 0x75, 0x6b, 0xbf, 0xf7, 0xf1, 0xd5, 0xd9,
+    0xc5, 0xfd, 0x30, 0x5b, 0xf4, 0xe3, 0x1e, 0xc6, 0xea, 0x7d, 0xb9, 0x5d, 0xbd, 0x8d, 0x76, 0xcf,
+    0x4c, 0xc1, 0xf2, 0x3a, 0x7b, 0x3f, 0xd6, 0xf7, 0x3a, 0x66, 0x5f, 0x2b, 0x5d, 0x01, 0xd0, 0x7a,
+    0x6f, 0xdb, 0x33, 0xde, 0xc7, 0x0e, 0x50, 0x58, 0x59, 0x9c, 0xdb, 0xaa, 0x81, 0x9a, 0xf7, 0x33,
+    0x5b, 0x49, 0xf0, 0x64, 0x4b, 0xe2, 0x8d, 0x0b, 0x2e, 0xb8, 0x32, 0x37, 0x7f, 0xec, 0xcc, 0x1e,
+    0xa3, 0x65, 0x40, 0x50, 0xf7, 0xf1, 0x31, 0xda, 0x64, 0xbd, 0xea, 0xe2, 0x01, 0xc8, 0x8d, 0x86,
+    0x1c, 0x74, 0xf4, 0xe8, 0x51, 0x3d, 0x2c, 0x54, 0x1a, 0xa3, 0x11, 0x87, 0x9d, 0xfc, 0x74, 0x52,
+    0x0f, 0x0b, 0x55, 0xc7, 0x68, 0xcc, 0x61, 0x7f, 0x3a, 0x19, 0x6a, 0xb0, 0x6d, 0xeb, 0x03, 0xa8,
+    0x0c, 0x79, 0x69, 0x73, 0x40, 0x39, 0x5b, 0x34, 0x5e, 0xef, 0x5c, 0xd2, 0xaa, 0x8f, 0xee, 0xc8,
+    0xcc, 0x08, 0x44, 0x90, 0x3c, 0xe8, 0x20, 0xe5, 0x1d, 0xd6, 0x7b, 0x9e, 0x20, 0xe5, 0x75, 0xff,
+    0x00, 0x3e, 0xe8, 0xb5, 0xde, 0x5e, 0x0a, 0x2a, 0x3b, 0x04, 0x0e, 0x58, 0x3d, 0xbf, 0x21, 0xb4,
+    0x72, 0x90, 0x88, 0xc9, 0x3a, 0x2e, 0xd4, 0x4e, 0x83, 0x43, 0x3c, 0xae, 0xde, 0x7a, 0xbe, 0x97,
+    0x52, 0xb4, 0xae, 0x85, 0x83, 0xf9, 0xb1, 0x66, 0xb7, 0xbb, 0xf0, 0x72, 0x5f, 0x7e, 0x9f, 0xb3,
+    0x53, 0x99, 0x98, 0xee, 0xc2, 0x92, 0x91, 0x96, 0x1e, 0xc0, 0xd6, 0xfb, 0x78, 0x6e, 0x73, 0xab,
+    0x4a, 0x9b, 0x85, 0xcd, 0x91, 0x0e, 0xeb, 0x2e, 0x55, 0x46, 0x75, 0x37, 0x2a, 0xe3, 0x7b, 0xbb,
+    0xed, 0x50, 0xe2, 0x16, 0xef, 0x7d, 0xcd, 0xf8, 0xe5, 0xf1, 0xde, 0x81, 0xcb, 0xde, 0x1d, 0xd2,
+    0xee, 0x5e, 0x8e, 0xdf, 0xb1, 0x9a, 0x1e, 0x97, 0xd2, 0xd5, 0x7b, 0xa1, 0x66, 0x0d, 0xe4, 0x96,
+    0xbc, 0xe5, 0x52, 0xcc, 0x28, 0xed, 0x95, 0x3c, 0x33, 0x96, 0x47, 0x66, 0x73, 0xf6, 0xe9, 0x7c,
+    0xc0, 0xb1, 0xca, 0xd5, 0x07, 0xe2, 0x96, 0x74, 0xc0, 0xfe, 0x6f, 0x64, 0xff, 0x05, 0x28, 0x61,
+    0xcb, 0x9a, 0xa4, 0x4c, 0x00, 0x00,
+};
@@ -0,0 +1,406 @@
+#pragma once
+
+#include <algorithm>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "Hal.h"
+#include "ProbeTable.h"
+
+// Hardware of a thermometer on a virtual clock, shared by the tests that run on the host.
+// Bus, ADC and HTTP calls take the time they take on the device, so awake times can be measured.
+
+// Bit timings of the OneWire standard speed
+const uint32_t US_ONEWIRE_RESET = 960;
+const uint32_t US_ONEWIRE_BYTE = 8 * 70;
+// Scratchpad value of a DS18B20 read before its first conversion finished
+const float TEMP_POWER_ON_RESET = 85.0F;
+const float TEMP_DISCONNECTED = -127.0F;
+// Rough costs of NVS on the ESP32, a lookup scans the entries of the namespace on its flash pages
+const uint32_t US_NVS_OPEN = 150;
+const uint32_t US_NVS_READ = 40;
+const uint32_t US_NVS_WRITE = 1500;
+
+struct SimulatedProbe
+{
+    uint8_t rom[LENGTH_PROBE_ROM];
+    float temp;
+    bool connected;
+    // Share of the nominal conversion time this probe needs, most finish well before it
+    float conversionFactor;
+};
+
+struct SimulatedRequest
+{
+    std::string method;
+    std::string address;
+    std::string body;
+    uint64_t atUs;
+};
+
+class SimulatedHal : public Hal
+{
+public:
+    // Virtual clock since the wake in microseconds and the wall clock, 0 until it was set
+    uint64_t nowUs = 0;
+    time_t wallTime = 0;
+    uint32_t randomState = 1;
+
+    std::vector<SimulatedProbe> bus;
+    uint8_t resolution = 12;
+    uint64_t conversionStartUs = 0;
+    bool converted = false;
+    uint32_t busTransactions = 0;
+    // Parasite powered probes hold the bus low while converting, so completion cannot be polled
+    bool parasitePower = false;
+
+    uint16_t adcRaw = 2200;
+    uint16_t adcNoise = 0;
+    uint32_t adcReadUs = 10;
+
+    // Namespaces of Preferences with their keys, values are stored as their bytes
+    std::map<std::string, std::map<std::string, std::vector<uint8_t>>> preferences;
+    std::string openSpace;
+    uint32_t preferenceOpens = 0;
+    uint32_t preferenceReads = 0;
+    uint32_t preferenceWrites = 0;
+
+    // RAM image of the flash file system, paths of the files mapped to their content
+    std::map<std::string, std::vector<uint8_t>> files;
+    std::set<std::string> directories;
+    uint32_t fileOperations = 0;
+
+    int httpStatus = 200;
+    uint32_t httpLatencyMs = 40;
+    std::vector<SimulatedRequest> requests;
+
+    unsigned int wakes = 0;
+    uint64_t lastSleepMicros = 0;
+
+    // DS18B20 with a serial number of its own, the ROM ends with its CRC like on real probes
+    SimulatedProbe &addProbe(float temp, float conversionFactor = 1.0F)
+    {
+        SimulatedProbe probe = {{0x28}, temp, true, conversionFactor};
+        uint32_t serial = 0x1F2000 + 0x10301 * (uint32_t)bus.size();
+        for (size_t i = 1; i < LENGTH_PROBE_ROM - 1; i++)
+            probe.rom[i] = (uint8_t)(serial >> (8 * (i - 1)));
+        probe.rom[LENGTH_PROBE_ROM - 1] = computeCrc8(probe.rom, LENGTH_PROBE_ROM - 1);
+        bus.push_back(probe);
+        return bus.back();
+    }
+
+    // Values written like by the Arduino Preferences, for keys the firmware itself no longer writes
+    void putPreference(const char *space, const char *key, const void *data, size_t length)
+    {
+        preferences[space][key] = std::vector<uint8_t>((const uint8_t *)data, (const uint8_t *)data + length);
+    }
+
+    void putPreference(const char *space, const char *key, const char *value) { putPreference(space, key, value, strlen(value)); }
+    void putPreference(const char *space, const char *key, bool value) { putPreference(space, key, &value, sizeof(value)); }
+    void putPreference(const char *space, const char *key, uint32_t value) { putPreference(space, key, &value, sizeof(value)); }
+    void putPreference(const char *space, const char *key, float value) { putPreference(space, key, &value, sizeof(value)); }
+
+    void advanceUs(uint64_t us)
+    {
+        uint64_t before = nowUs / 1000000;
+        nowUs += us;
+        if (wallTime > 0)
+            wallTime += (time_t)(nowUs / 1000000 - before);
+    }
+
+    uint32_t millis() override { return (uint32_t)(nowUs / 1000); }
+    uint32_t micros() override { return (uint32_t)nowUs; }
+    void delay(uint32_t ms) override { advanceUs((uint64_t)ms * 1000); }
+    time_t time() override { return wallTime; }
+
+    uint32_t random() override
+    {
+        randomState = randomState * 1103515245 + 12345;
+        return randomState;
+    }
+
+    unsigned int probeCount() override { return bus.size(); }
+    uint8_t getResolution() override { return resolution; }
+
+    void setResolution(uint8_t bits) override
+    {
+        // Written to the scratchpad of every probe
+        transaction(US_ONEWIRE_RESET + (2 + 3) * US_ONEWIRE_BYTE * bus.size());
+        resolution = bits;
+    }
+
+    uint32_t millisToWaitForConversion(uint8_t bits) override { return 750 / (1 << (12 - bits)); }
+
+    void requestTemperatures() override
+    {
+        // Skip ROM and convert, addressed to all probes at once
+        transaction(US_ONEWIRE_RESET + 2 * US_ONEWIRE_BYTE);
+        conversionStartUs = nowUs;
+        converted = true;
+    }
+
+    // Read slots return 1 once every probe finished
+    bool isConversionComplete() override
+    {
+        transaction(70);
+        if (parasitePower)
+            return false;
+
+        for (const SimulatedProbe &probe : bus)
+        {
+            if (probe.connected && nowUs < conversionStartUs + conversionUs(probe))
+                return false;
+        }
+
+        return true;
+    }
+
+    float getTempC(unsigned int index) override
+    {
+        // Match ROM with the address and read the scratchpad
+        transaction(US_ONEWIRE_RESET + (1 + 8 + 1 + 9) * US_ONEWIRE_BYTE);
+        if (index >= bus.size() || !bus[index].connected)
+            return TEMP_DISCONNECTED;
+
+        const SimulatedProbe &probe = bus[index];
+        if (!converted || nowUs < conversionStartUs + conversionUs(probe))
+            return TEMP_POWER_ON_RESET;
+
+        // Lower resolutions leave the last bits undefined, the DS18B20 reads them as 0
+        float step = 0.0625F * (1 << (12 - resolution));
+        return floorf(probe.temp / step) * step;
+    }
+
+    uint16_t analogReadBattery() override
+    {
+        advanceUs(adcReadUs);
+        if (adcNoise == 0)
+            return adcRaw;
+
+        return adcRaw - adcNoise + random() % (2 * adcNoise + 1);
+    }
+
+    // Linear like a calibrated ADC at 11 dB behind the 1:1 divider
+    uint32_t batteryMillivoltsFrom(uint32_t raw) override { return raw * 2 * 3300 / 4095; }
+
+    bool beginPreferences(const char *space, bool readOnly) override
+    {
+        preferenceOpens++;
+        advanceUs(US_NVS_OPEN);
+        openSpace = space;
+        return true;
+    }
+
+    void endPreferences() override { openSpace.clear(); }
+    bool isKey(const char *key) override { return findPreference(key) != NULL; }
+
+    bool getBool(const char *key, bool fallback) override
+    {
+        bool value = fallback;
+        readPreference(key, &value, sizeof(value));
+        return value;
+    }
+
+    uint32_t getUInt(const char *key, uint32_t fallback) override
+    {
+        uint32_t value = fallback;
+        readPreference(key, &value, sizeof(value));
+        return value;
+    }
+
+    float getFloat(const char *key, float fallback) override
+    {
+        float value = fallback;
+        readPreference(key, &value, sizeof(value));
+        return value;
+    }
+
+    void getString(const char *key, const char *fallback, char *buffer, size_t length) override
+    {
+        const std::vector<uint8_t> *value = findPreference(key);
+        std::string text = value != NULL ? std::string(value->begin(), value->end()) : fallback;
+        snprintf(buffer, length, "%s", text.c_str());
+    }
+
+    size_t getBytes(const char *key, void *buffer, size_t length) override
+    {
+        const std::vector<uint8_t> *value = findPreference(key);
+        if (value == NULL || value->size() > length)
+            return 0;
+
+        memcpy(buffer, value->data(), value->size());
+        return value->size();
+    }
+
+    size_t putUInt(const char *key, uint32_t value) override { return writePreference(key, &value, sizeof(value)); }
+    size_t putString(const char *key, const char *value) override { return writePreference(key, value, strlen(value)); }
+    size_t putBytes(const char *key, const void *data, size_t length) override { return writePreference(key, data, length); }
+
+    bool removeKey(const char *key) override
+    {
+        preferenceWrites++;
+        advanceUs(US_NVS_WRITE);
+        return preferences[openSpace].erase(key) > 0;
+    }
+
+    bool clearPreferences() override
+    {
+        preferenceWrites++;
+        advanceUs(US_NVS_WRITE);
+        preferences[openSpace].clear();
+        return true;
+    }
+
+    bool mountFiles() override { return true; }
+
+    bool makeDirectory(const char *path) override
+    {
+        directories.insert(path);
+        return true;
+    }
+
+    // Names without the directory, like the File of the Arduino core 2
+    bool listFiles(const char *directory, FileVisitor visit, void *context) override
+    {
+        fileOperations++;
+        if (directories.count(directory) == 0)
+            return false;
+
+        std::string prefix = std::string(directory) + "/";
+        for (std::map<std::string, std::vector<uint8_t>>::const_iterator file = files.lower_bound(prefix);
+             file != files.end() && file->first.compare(0, prefix.size(), prefix) == 0; ++file)
+            visit(file->first.c_str() + prefix.size(), file->second.size(), context);
+
+        return true;
+    }
+
+    size_t appendFile(const char *path, const void *data, size_t length) override
+    {
+        fileOperations++;
+        std::vector<uint8_t> &file = files[path];
+        file.insert(file.end(), (const uint8_t *)data, (const uint8_t *)data + length);
+        return length;
+    }
+
+    size_t readFile(const char *path, size_t offset, void *buffer, size_t length) override
+    {
+        fileOperations++;
+        std::map<std::string, std::vector<uint8_t>>::const_iterator found = files.find(path);
+        if (found == files.end() || offset > found->second.size())
+            return 0;
+
+        size_t read = found->second.size() - offset < length ? found->second.size() - offset : length;
+        memcpy(buffer, found->second.data() + offset, read);
+        return read;
+    }
+
+    bool removeFile(const char *path) override
+    {
+        fileOperations++;
+        return files.erase(path) > 0;
+    }
+
+    int sendRequest(const char *method, const char *address, const char *contentType, const char *body, size_t length) override
+    {
+        SimulatedRequest request = {method, address, std::string(body, length), nowUs};
+        requests.push_back(request);
+        advanceUs((uint64_t)httpLatencyMs * 1000);
+
+        return httpStatus;
+    }
+
+    // The RTC keeps the wall clock, everything else starts over on the next wake
+    void deepSleep(uint64_t micros) override
+    {
+        lastSleepMicros = micros;
+        if (wallTime > 0)
+            wallTime += (time_t)(micros / 1000000);
+        nowUs = 0;
+        converted = false;
+        wakes++;
+    }
+
+    // Only probes answer that are connected, in the order the search algorithm of OneWire finds them
+    void resetBusSearch() override
+    {
+        searched.clear();
+        for (const SimulatedProbe &probe : bus)
+        {
+            if (probe.connected)
+                searched.push_back(std::vector<uint8_t>(probe.rom, probe.rom + LENGTH_PROBE_ROM));
+        }
+        std::sort(searched.begin(), searched.end(), isFoundBefore);
+        searchIndex = 0;
+    }
+
+    bool searchBus(uint8_t *rom) override
+    {
+        if (searchIndex >= searched.size())
+            return false;
+
+        // Reset, search command and three time slots for every bit of the ROM
+        transaction(US_ONEWIRE_RESET + US_ONEWIRE_BYTE + 3 * 8 * LENGTH_PROBE_ROM * (US_ONEWIRE_BYTE / 8));
+        memcpy(rom, searched[searchIndex++].data(), LENGTH_PROBE_ROM);
+        return true;
+    }
+
+private:
+    std::vector<std::vector<uint8_t>> searched;
+    size_t searchIndex = 0;
+
+    // The search takes the 0 branch first and goes from the lowest bit of the first byte to the CRC
+    static bool isFoundBefore(const std::vector<uint8_t> &a, const std::vector<uint8_t> &b)
+    {
+        for (size_t bit = 0; bit < 8 * LENGTH_PROBE_ROM; bit++)
+        {
+            int bitA = a[bit / 8] >> bit % 8 & 1;
+            int bitB = b[bit / 8] >> bit % 8 & 1;
+            if (bitA != bitB)
+                return bitA < bitB;
+        }
+
+        return false;
+    }
+
+    const std::vector<uint8_t> *findPreference(const char *key)
+    {
+        preferenceReads++;
+        advanceUs(US_NVS_READ);
+        std::map<std::string, std::vector<uint8_t>> &space = preferences[openSpace];
+        std::map<std::string, std::vector<uint8_t>>::const_iterator found = space.find(key);
+        return found != space.end() ? &found->second : NULL;
+    }
+
+    // Values of another size were written with another type and read as missing, like NVS does
+    void readPreference(const char *key, void *value, size_t length)
+    {
+        const std::vector<uint8_t> *stored = findPreference(key);
+        if (stored != NULL && stored->size() == length)
+            memcpy(value, stored->data(), length);
+    }
+
+    size_t writePreference(const char *key, const void *data, size_t length)
+    {
+        preferenceWrites++;
+        advanceUs(US_NVS_WRITE);
+        preferences[openSpace][key] = std::vector<uint8_t>((const uint8_t *)data, (const uint8_t *)data + length);
+        return length;
+    }
+
+    uint64_t conversionUs(const SimulatedProbe &probe)
+    {
+        return (uint64_t)(millisToWaitForConversion(resolution) * 1000 * probe.conversionFactor);
+    }
+
+    void transaction(uint32_t us)
+    {
+        busTransactions++;
+        advanceUs(us);
+    }
+};
@@ -0,0 +1,170 @@
+#include <unity.h>
+
+#include <chrono>
+#include <stdio.h>
+#include <string.h>
+
+#include "BatchPayload.h"
+
+// Both payload formats, a full buffer and the serialization throughput
+
+const time_t START_TIME = 1700000000;
+// Payload of one TCP segment on Ethernet and WiFi
+const size_t BYTES_TCP_SEGMENT = 1460;
+
+char buffer[2048];
+BatchWriter writer;
+
+void setUp(void)
+{
+    memset(buffer, 0, sizeof(buffer));
+}
+
+void tearDown(void)
+{
+}
+
+void test_influx_lines(void)
+{
+    beginBatch(writer, BATCH_FORMAT_INFLUX, buffer, sizeof(buffer), "garden");
+    TEST_ASSERT_TRUE(addBatchSample(writer, NULL, START_TIME, 21.375F, 0.85F));
+    TEST_ASSERT_TRUE(addBatchSample(writer, "pond", START_TIME, 14.5F, -1.0F));
+    TEST_ASSERT_TRUE(addBatchStatus(writer, START_TIME, -67, 812));
+
+    size_t length = finishBatch(writer);
+    const char *expected = "thermometer,sensor=garden temp=21.38,battery=0.850 1700000000000000000\n"
+                           "thermometer,sensor=garden,probe=pond temp=14.50 1700000000000000000\n"
+                           "thermometer_status,sensor=garden rssi=-67i,awake_ms=812i 1700000000000000000\n";
+    TEST_ASSERT_EQUAL_STRING(expected, buffer);
+    TEST_ASSERT_EQUAL(strlen(expected), length);
+    TEST_ASSERT_EQUAL(3, writer.entries);
+}
+
+void test_json_array(void)
+{
+    beginBatch(writer, BATCH_FORMAT_JSON, buffer, sizeof(buffer), "garden");
+    TEST_ASSERT_TRUE(addBatchSample(writer, NULL, START_TIME, 21.375F, 0.85F));
+    TEST_ASSERT_TRUE(addBatchSample(writer, "pond", START_TIME, 14.5F, -1.0F));
+    TEST_ASSERT_TRUE(addBatchStatus(writer, START_TIME, -67, 812));
+    finishBatch(writer);
+
+    TEST_ASSERT_EQUAL_STRING("[{\"sensor\":\"garden\",\"temp\":21.38,\"battery\":0.850,\"time\":1700000000},"
+                             "{\"sensor\":\"garden\",\"probe\":\"pond\",\"temp\":14.50,\"time\":1700000000},"
+                             "{\"sensor\":\"garden\",\"rssi\":-67,\"awakeMs\":812,\"time\":1700000000}]",
+                             buffer);
+}
+
+void test_empty_json_array(void)
+{
+    beginBatch(writer, BATCH_FORMAT_JSON, buffer, sizeof(buffer), "garden");
+
+    TEST_ASSERT_EQUAL(2, finishBatch(writer));
+    TEST_ASSERT_EQUAL_STRING("[]", buffer);
+}
+
+void test_times_of_an_unset_clock_are_left_out(void)
+{
+    beginBatch(writer, BATCH_FORMAT_INFLUX, buffer, sizeof(buffer), "garden");
+    addBatchSample(writer, NULL, 42, 21.0F, -1.0F);
+    finishBatch(writer);
+    TEST_ASSERT_EQUAL_STRING("thermometer,sensor=garden temp=21.00\n", buffer);
+
+    beginBatch(writer, BATCH_FORMAT_JSON, buffer, sizeof(buffer), "garden");
+    addBatchSample(writer, NULL, 42, 21.0F, -1.0F);
+    finishBatch(writer);
+    TEST_ASSERT_EQUAL_STRING("[{\"sensor\":\"garden\",\"temp\":21.00}]", buffer);
+}
+
+void test_names_are_escaped(void)
+{
+    beginBatch(writer, BATCH_FORMAT_INFLUX, buffer, sizeof(buffer), "living room,1=a");
+    addBatchSample(writer, NULL, 0, 21.0F, -1.0F);
+    finishBatch(writer);
+    TEST_ASSERT_EQUAL_STRING("thermometer,sensor=living\\ room\\,1\\=a temp=21.00\n", buffer);
+
+    beginBatch(writer, BATCH_FORMAT_JSON, buffer, sizeof(buffer), "say \"hi\"\\\n");
+    addBatchSample(writer, NULL, 0, 21.0F, -1.0F);
+    finishBatch(writer);
+    TEST_ASSERT_EQUAL_STRING("[{\"sensor\":\"say \\\"hi\\\"\\\\\",\"temp\":21.00}]", buffer);
+}
+
+void test_full_buffer_keeps_a_valid_payload(void)
+{
+    const BatchFormat formats[] = {BATCH_FORMAT_INFLUX, BATCH_FORMAT_JSON};
+    for (BatchFormat format : formats)
+    {
+        char small[200];
+        beginBatch(writer, format, small, sizeof(small), "garden");
+
+        unsigned int added = 0;
+        while (addBatchSample(writer, NULL, START_TIME + added, 21.0F, 0.9F))
+            added++;
+
+        // The entry that did not fit left nothing behind
+        size_t before = writer.length;
+        TEST_ASSERT_FALSE(addBatchSample(writer, "pond", START_TIME, 21.0F, 0.9F));
+        TEST_ASSERT_EQUAL(before, writer.length);
+        TEST_ASSERT_EQUAL(added, writer.entries);
+
+        size_t length = finishBatch(writer);
+        TEST_ASSERT_GREATER_THAN(0, added);
+        TEST_ASSERT_LESS_THAN(sizeof(small), length);
+        TEST_ASSERT_EQUAL(strlen(small), length);
+        if (format == BATCH_FORMAT_JSON)
+            TEST_ASSERT_EQUAL(']', small[length - 1]);
+        else
+            TEST_ASSERT_EQUAL('\n', small[length - 1]);
+    }
+}
+
+void test_too_small_buffer(void)
+{
+    char tiny[1];
+    beginBatch(writer, BATCH_FORMAT_JSON, tiny, sizeof(tiny), "garden");
+
+    TEST_ASSERT_FALSE(addBatchSample(writer, NULL, START_TIME, 21.0F, 0.9F));
+    TEST_ASSERT_EQUAL(0, finishBatch(writer));
+}
+
+void test_benchmark_serialization(void)
+{
+    const unsigned int rounds = 20000;
+    const BatchFormat formats[] = {BATCH_FORMAT_INFLUX, BATCH_FORMAT_JSON};
+    const char *names[] = {"InfluxDB", "JSON"};
+
+    for (unsigned int i = 0; i < 2; i++)
+    {
+        unsigned long samples = 0;
+        size_t length = 0;
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        for (unsigned int round = 0; round < rounds; round++)
+        {
+            beginBatch(writer, formats[i], buffer, sizeof(buffer), "garden");
+            for (unsigned int sample = 0; addBatchSample(writer, NULL, START_TIME + sample * 60, 21.0F + sample / 100.0F, 0.85F); sample++)
+                samples++;
+            length = finishBatch(writer);
+        }
+        double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        float bytesPerSample = (float)length / writer.entries;
+        char message[160];
+        snprintf(message, sizeof(message), "%s: %.2f M samples/s, %.1f bytes per sample, %u samples per TCP segment",
+                 names[i], samples / secs / 1e6, bytesPerSample, (unsigned int)(BYTES_TCP_SEGMENT / bytesPerSample));
+        TEST_MESSAGE(message);
+        TEST_ASSERT_GREATER_THAN(0, writer.entries);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_influx_lines);
+    RUN_TEST(test_json_array);
+    RUN_TEST(test_empty_json_array);
+    RUN_TEST(test_times_of_an_unset_clock_are_left_out);
+    RUN_TEST(test_names_are_escaped);
+    RUN_TEST(test_full_buffer_keeps_a_valid_payload);
+    RUN_TEST(test_too_small_buffer);
+    RUN_TEST(test_benchmark_serialization);
+    return UNITY_END();
+}
@@ -0,0 +1,137 @@
+#include <unity.h>
+
+#include "../SimulatedHal.h"
+#include "BatteryLevel.h"
+
+// Outlier rejection, the time budget of the burst and the Li-ion curve
+
+SimulatedHal hal;
+
+// The curve is evaluated at compile time as well
+static_assert(batteryLevelFrom(4200) == 1.0F, "Full cell");
+static_assert(batteryLevelFrom(2500) == 0.0F, "Empty cell");
+
+void setUp(void)
+{
+    hal = SimulatedHal();
+}
+
+void tearDown(void)
+{
+}
+
+void test_trimmed_mean_without_samples(void)
+{
+    TEST_ASSERT_EQUAL(0, trimmedMean(NULL, 0));
+}
+
+void test_trimmed_mean_of_few_samples(void)
+{
+    uint16_t one[] = {2000};
+    TEST_ASSERT_EQUAL(2000, trimmedMean(one, 1));
+
+    // Nothing is dropped below four samples, the mean is rounded
+    uint16_t three[] = {2001, 2000, 2000};
+    TEST_ASSERT_EQUAL(2000, trimmedMean(three, 3));
+}
+
+void test_trimmed_mean_drops_spikes(void)
+{
+    uint16_t samples[40];
+    for (size_t i = 0; i < 40; i++)
+        samples[i] = 2000 + i % 5;
+    // Spikes in both directions, fewer than the quarter dropped on each side
+    for (size_t i = 0; i < 10; i += 2)
+    {
+        samples[i] = 4095;
+        samples[i + 1] = 0;
+    }
+
+    TEST_ASSERT_EQUAL(2002, trimmedMean(samples, 40));
+}
+
+void test_curve_end_points_and_clamping(void)
+{
+    TEST_ASSERT_EQUAL_FLOAT(0.0F, batteryLevelFrom(0));
+    TEST_ASSERT_EQUAL_FLOAT(0.0F, batteryLevelFrom(3000));
+    TEST_ASSERT_EQUAL_FLOAT(1.0F, batteryLevelFrom(4200));
+    TEST_ASSERT_EQUAL_FLOAT(1.0F, batteryLevelFrom(5000));
+}
+
+void test_curve_interpolates_between_points(void)
+{
+    TEST_ASSERT_EQUAL_FLOAT(0.5F, batteryLevelFrom(3830));
+    TEST_ASSERT_FLOAT_WITHIN(0.0001F, 0.55F, batteryLevelFrom(3850));
+    TEST_ASSERT_FLOAT_WITHIN(0.0001F, 0.025F, batteryLevelFrom(3150));
+
+    float previous = 0.0F;
+    for (uint32_t millivolts = 2900; millivolts <= 4300; millivolts++)
+    {
+        TEST_ASSERT_GREATER_OR_EQUAL(previous, batteryLevelFrom(millivolts));
+        previous = batteryLevelFrom(millivolts);
+    }
+}
+
+void test_fast_adc_is_capped_by_the_buffer(void)
+{
+    uint32_t raw;
+    size_t sampleCount;
+    uint32_t millivolts = sampleBatteryMillivolts(hal, raw, sampleCount);
+
+    TEST_ASSERT_EQUAL(MAX_SAMPLES_BATTERY, sampleCount);
+    TEST_ASSERT_EQUAL(2200, raw);
+    TEST_ASSERT_EQUAL(hal.batteryMillivoltsFrom(2200), millivolts);
+    TEST_ASSERT_EQUAL(MAX_SAMPLES_BATTERY * hal.adcReadUs, hal.micros());
+}
+
+void test_slow_adc_stops_at_the_budget(void)
+{
+    hal.adcReadUs = 700;
+
+    uint32_t raw;
+    size_t sampleCount;
+    sampleBatteryMillivolts(hal, raw, sampleCount);
+
+    // The last read starts before the budget is over and may end after it
+    TEST_ASSERT_EQUAL((BUDGET_US_BATTERY + hal.adcReadUs - 1) / hal.adcReadUs, sampleCount);
+    TEST_ASSERT_LESS_THAN(BUDGET_US_BATTERY + hal.adcReadUs, hal.micros());
+}
+
+void test_takes_one_sample_even_without_budget(void)
+{
+    hal.adcReadUs = 2 * BUDGET_US_BATTERY;
+
+    uint32_t raw;
+    size_t sampleCount;
+    sampleBatteryMillivolts(hal, raw, sampleCount);
+
+    TEST_ASSERT_EQUAL(1, sampleCount);
+    TEST_ASSERT_EQUAL(2200, raw);
+}
+
+void test_noise_is_averaged_out(void)
+{
+    hal.adcNoise = 60;
+
+    uint32_t raw;
+    size_t sampleCount;
+    uint32_t millivolts = sampleBatteryMillivolts(hal, raw, sampleCount);
+
+    TEST_ASSERT_LESS_OR_EQUAL(10, raw > 2200 ? raw - 2200 : 2200 - raw);
+    TEST_ASSERT_FLOAT_WITHIN(0.02F, batteryLevelFrom(hal.batteryMillivoltsFrom(2200)), batteryLevelFrom(millivolts));
+}
+
+int main(int argc, char **argv)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_trimmed_mean_without_samples);
+    RUN_TEST(test_trimmed_mean_of_few_samples);
+    RUN_TEST(test_trimmed_mean_drops_spikes);
+    RUN_TEST(test_curve_end_points_and_clamping);
+    RUN_TEST(test_curve_interpolates_between_points);
+    RUN_TEST(test_fast_adc_is_capped_by_the_buffer);
+    RUN_TEST(test_slow_adc_stops_at_the_budget);
+    RUN_TEST(test_takes_one_sample_even_without_budget);
+    RUN_TEST(test_noise_is_averaged_out);
+    return UNITY_END();
+}
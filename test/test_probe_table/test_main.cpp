@@ -0,0 +1,179 @@
+#include <unity.h>
+
+#include <string.h>
+
+#include "../SimulatedHal.h"
+#include "ProbeTable.h"
+
+// Enumerating several simulated probes and keeping their names and addresses mapped to the right ROM
+
+SimulatedHal hal;
+Probe probes[MAX_PROBES];
+unsigned int probeCount;
+bool present[MAX_PROBES];
+
+// Index of the probe on the bus, which is not the order the search finds them in
+static int findOnBus(const uint8_t *rom)
+{
+    for (size_t i = 0; i < hal.bus.size(); i++)
+    {
+        if (memcmp(hal.bus[i].rom, rom, LENGTH_PROBE_ROM) == 0)
+            return i;
+    }
+
+    return -1;
+}
+
+void setUp(void)
+{
+    hal = SimulatedHal();
+    memset(probes, 0, sizeof(probes));
+    probeCount = 0;
+}
+
+void tearDown(void)
+{
+}
+
+void test_crc_of_the_rom_in_the_data_sheet(void)
+{
+    const uint8_t rom[LENGTH_PROBE_ROM] = {0x02, 0x1C, 0xB8, 0x01, 0x00, 0x00, 0x00, 0xA2};
+
+    TEST_ASSERT_EQUAL(0xA2, computeCrc8(rom, LENGTH_PROBE_ROM - 1));
+    TEST_ASSERT_EQUAL(0, computeCrc8(rom, LENGTH_PROBE_ROM));
+}
+
+void test_probes_are_named_by_their_rom(void)
+{
+    for (unsigned int i = 0; i < 4; i++)
+        hal.addProbe(20.0F + i);
+
+    TEST_ASSERT_EQUAL(4, enumerateProbes(hal, probes, probeCount, present));
+    TEST_ASSERT_EQUAL(4, probeCount);
+
+    bool found[4] = {false};
+    for (unsigned int i = 0; i < probeCount; i++)
+    {
+        int onBus = findOnBus(probes[i].rom);
+        TEST_ASSERT_TRUE(onBus >= 0);
+        TEST_ASSERT_FALSE(found[onBus]);
+        found[onBus] = true;
+
+        char name[LENGTH_ROM_STRING];
+        formatRom(hal.bus[onBus].rom, name);
+        TEST_ASSERT_EQUAL_STRING(name, probes[i].name);
+        TEST_ASSERT_EQUAL_STRING("", probes[i].reportAddress);
+        TEST_ASSERT_TRUE(present[i]);
+        TEST_ASSERT_EQUAL(i, findProbe(probes, probeCount, probes[i].rom));
+    }
+}
+
+void test_names_and_addresses_stay_with_their_rom(void)
+{
+    for (unsigned int i = 0; i < 3; i++)
+        hal.addProbe(20.0F);
+    enumerateProbes(hal, probes, probeCount, present);
+
+    // Named after their place on the bus, so a mix up of the slots shows
+    for (unsigned int i = 0; i < probeCount; i++)
+    {
+        int onBus = findOnBus(probes[i].rom);
+        snprintf(probes[i].name, sizeof(probes[i].name), "probe %d", onBus);
+        snprintf(probes[i].reportAddress, sizeof(probes[i].reportAddress), "http://collector/probe/%d", onBus);
+    }
+    writeStoredProbes(hal, probes, probeCount);
+
+    Probe stored[MAX_PROBES];
+    unsigned int storedCount = 0;
+    readStoredProbes(hal, stored, storedCount);
+    TEST_ASSERT_EQUAL(probeCount, storedCount);
+    for (unsigned int i = 0; i < storedCount; i++)
+    {
+        int onBus = findOnBus(stored[i].rom);
+        char name[LENGTH_SETTING_NAME];
+        snprintf(name, sizeof(name), "probe %d", onBus);
+        TEST_ASSERT_EQUAL_MEMORY(probes[i].rom, stored[i].rom, LENGTH_PROBE_ROM);
+        TEST_ASSERT_EQUAL_STRING(name, stored[i].name);
+        TEST_ASSERT_EQUAL_STRING(probes[i].reportAddress, stored[i].reportAddress);
+    }
+
+    // The next cold boot finds the same probes and adds none
+    TEST_ASSERT_EQUAL(0, enumerateProbes(hal, stored, storedCount, present));
+    TEST_ASSERT_EQUAL(3, storedCount);
+}
+
+void test_missing_probe_keeps_its_slot(void)
+{
+    for (unsigned int i = 0; i < 3; i++)
+        hal.addProbe(20.0F);
+    enumerateProbes(hal, probes, probeCount, present);
+    Probe before[MAX_PROBES];
+    memcpy(before, probes, sizeof(probes));
+
+    hal.bus[findOnBus(probes[1].rom)].connected = false;
+    hal.addProbe(25.0F);
+    TEST_ASSERT_EQUAL(1, enumerateProbes(hal, probes, probeCount, present));
+
+    TEST_ASSERT_EQUAL(4, probeCount);
+    for (unsigned int i = 0; i < 3; i++)
+        TEST_ASSERT_EQUAL_MEMORY(before[i].rom, probes[i].rom, LENGTH_PROBE_ROM);
+    TEST_ASSERT_TRUE(present[0]);
+    TEST_ASSERT_FALSE(present[1]);
+    TEST_ASSERT_TRUE(present[2]);
+    TEST_ASSERT_TRUE(present[3]);
+    TEST_ASSERT_EQUAL_MEMORY(hal.bus[3].rom, probes[3].rom, LENGTH_PROBE_ROM);
+}
+
+void test_other_devices_and_bad_roms_are_skipped(void)
+{
+    // A DS2401 serial number with a valid CRC and a DS18B20 with a corrupted one
+    SimulatedProbe &serialNumber = hal.addProbe(20.0F);
+    serialNumber.rom[0] = 0x01;
+    serialNumber.rom[LENGTH_PROBE_ROM - 1] = computeCrc8(serialNumber.rom, LENGTH_PROBE_ROM - 1);
+    hal.addProbe(20.0F).rom[3] ^= 0x10;
+    hal.addProbe(20.0F);
+
+    TEST_ASSERT_EQUAL(1, enumerateProbes(hal, probes, probeCount, present));
+    TEST_ASSERT_EQUAL_MEMORY(hal.bus[2].rom, probes[0].rom, LENGTH_PROBE_ROM);
+}
+
+void test_table_is_limited(void)
+{
+    for (unsigned int i = 0; i < MAX_PROBES + 2; i++)
+        hal.addProbe(20.0F);
+
+    TEST_ASSERT_EQUAL(MAX_PROBES, enumerateProbes(hal, probes, probeCount, present));
+    TEST_ASSERT_EQUAL(MAX_PROBES, probeCount);
+
+    writeStoredProbes(hal, probes, probeCount);
+    Probe stored[MAX_PROBES];
+    unsigned int storedCount = 0;
+    readStoredProbes(hal, stored, storedCount);
+    TEST_ASSERT_EQUAL(MAX_PROBES, storedCount);
+}
+
+void test_fewer_probes_leave_no_stale_keys(void)
+{
+    for (unsigned int i = 0; i < 3; i++)
+        hal.addProbe(20.0F);
+    enumerateProbes(hal, probes, probeCount, present);
+    writeStoredProbes(hal, probes, probeCount);
+
+    writeStoredProbes(hal, probes, 1);
+
+    // Count, ROM, name and address of the one probe left
+    TEST_ASSERT_EQUAL(1 + 3, hal.preferences[PREFS_NAME_PROBES].size());
+}
+
+int main(int argc, char **argv)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_crc_of_the_rom_in_the_data_sheet);
+    RUN_TEST(test_probes_are_named_by_their_rom);
+    RUN_TEST(test_names_and_addresses_stay_with_their_rom);
+    RUN_TEST(test_missing_probe_keeps_its_slot);
+    RUN_TEST(test_other_devices_and_bad_roms_are_skipped);
+    RUN_TEST(test_table_is_limited);
+    RUN_TEST(test_fewer_probes_leave_no_stale_keys);
+    return UNITY_END();
+}
@@ -0,0 +1,175 @@
+#include <unity.h>
+
+#include <chrono>
+#include <stdio.h>
+#include <string.h>
+
+#include "ReadingDatagram.h"
+
+// Round trips of reading datagrams, what a receiver has to reject and the cost of encoding and decoding
+
+ReadingDatagram datagram;
+uint8_t buffer[MAX_SIZE_READING_DATAGRAM];
+
+void setUp(void)
+{
+    memset(&datagram, 0, sizeof(datagram));
+    datagram.sequence = 513;
+    datagram.time = 1760000000;
+    datagram.tempValid = true;
+    datagram.temp = -12.34F;
+    datagram.batteryValid = true;
+    datagram.batteryStatus = 0.873F;
+    datagram.rssi = -67;
+    strcpy(datagram.name, "kitchen");
+    datagram.probeCount = 2;
+    datagram.probeValid[0] = true;
+    datagram.probeTemps[0] = 21.5F;
+    datagram.probeValid[1] = false;
+}
+
+void tearDown(void)
+{
+}
+
+void test_round_trip(void)
+{
+    size_t length = encodeReadingDatagram(datagram, buffer, sizeof(buffer));
+    TEST_ASSERT_EQUAL(LENGTH_DATAGRAM_HEADER + 7 + 1 + 2 * 2 + 2, length);
+
+    ReadingDatagram decoded;
+    TEST_ASSERT_TRUE(decodeReadingDatagram(buffer, length, decoded));
+    TEST_ASSERT_EQUAL(513, decoded.sequence);
+    TEST_ASSERT_EQUAL(1760000000, decoded.time);
+    TEST_ASSERT_TRUE(decoded.tempValid);
+    TEST_ASSERT_FLOAT_WITHIN(0.005F, -12.34F, decoded.temp);
+    TEST_ASSERT_TRUE(decoded.batteryValid);
+    TEST_ASSERT_FLOAT_WITHIN(0.0005F, 0.873F, decoded.batteryStatus);
+    TEST_ASSERT_EQUAL(-67, decoded.rssi);
+    TEST_ASSERT_EQUAL_STRING("kitchen", decoded.name);
+    TEST_ASSERT_EQUAL(2, decoded.probeCount);
+    TEST_ASSERT_TRUE(decoded.probeValid[0]);
+    TEST_ASSERT_FLOAT_WITHIN(0.005F, 21.5F, decoded.probeTemps[0]);
+    TEST_ASSERT_FALSE(decoded.probeValid[1]);
+}
+
+void test_invalid_values_are_left_out(void)
+{
+    datagram.tempValid = false;
+    datagram.batteryValid = false;
+    datagram.time = 0;
+    size_t length = encodeReadingDatagram(datagram, buffer, sizeof(buffer));
+
+    ReadingDatagram decoded;
+    TEST_ASSERT_TRUE(decodeReadingDatagram(buffer, length, decoded));
+    TEST_ASSERT_FALSE(decoded.tempValid);
+    TEST_ASSERT_FALSE(decoded.batteryValid);
+    TEST_ASSERT_EQUAL(0, decoded.time);
+}
+
+void test_long_names_and_many_probes_are_cut_off(void)
+{
+    memset(datagram.name, 'x', MAX_DATAGRAM_NAME);
+    datagram.name[MAX_DATAGRAM_NAME] = '\0';
+    datagram.probeCount = MAX_DATAGRAM_PROBES + 3;
+
+    size_t length = encodeReadingDatagram(datagram, buffer, sizeof(buffer));
+    TEST_ASSERT_EQUAL(MAX_SIZE_READING_DATAGRAM, length);
+
+    ReadingDatagram decoded;
+    TEST_ASSERT_TRUE(decodeReadingDatagram(buffer, length, decoded));
+    TEST_ASSERT_EQUAL(MAX_DATAGRAM_NAME, strlen(decoded.name));
+    TEST_ASSERT_EQUAL(MAX_DATAGRAM_PROBES, decoded.probeCount);
+}
+
+void test_too_small_buffer(void)
+{
+    TEST_ASSERT_EQUAL(0, encodeReadingDatagram(datagram, buffer, 10));
+}
+
+void test_every_flipped_bit_is_rejected(void)
+{
+    size_t length = encodeReadingDatagram(datagram, buffer, sizeof(buffer));
+
+    ReadingDatagram decoded;
+    for (size_t bit = 0; bit < length * 8; bit++)
+    {
+        buffer[bit / 8] ^= 1 << bit % 8;
+        TEST_ASSERT_FALSE(decodeReadingDatagram(buffer, length, decoded));
+        buffer[bit / 8] ^= 1 << bit % 8;
+    }
+    TEST_ASSERT_TRUE(decodeReadingDatagram(buffer, length, decoded));
+}
+
+void test_newer_version_is_rejected(void)
+{
+    size_t length = encodeReadingDatagram(datagram, buffer, sizeof(buffer));
+
+    // Whatever the CRC, so also with the one that matches, a newer layout cannot be read
+    buffer[2] = READING_DATAGRAM_VERSION + 1;
+    for (uint32_t candidate = 0; candidate <= 0xFFFF; candidate++)
+    {
+        buffer[length - 2] = (uint8_t)candidate;
+        buffer[length - 1] = (uint8_t)(candidate >> 8);
+        ReadingDatagram decoded;
+        TEST_ASSERT_FALSE(decodeReadingDatagram(buffer, length, decoded));
+    }
+}
+
+void test_truncated_and_padded_datagrams_are_rejected(void)
+{
+    size_t length = encodeReadingDatagram(datagram, buffer, sizeof(buffer));
+
+    ReadingDatagram decoded;
+    for (size_t truncated = 0; truncated < length; truncated++)
+        TEST_ASSERT_FALSE(decodeReadingDatagram(buffer, truncated, decoded));
+
+    uint8_t padded[MAX_SIZE_READING_DATAGRAM + 1];
+    memcpy(padded, buffer, length);
+    padded[length] = 0;
+    TEST_ASSERT_FALSE(decodeReadingDatagram(padded, length + 1, decoded));
+}
+
+void test_benchmark_encode_and_decode(void)
+{
+    const unsigned int rounds = 1000000;
+    size_t length = 0;
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (unsigned int i = 0; i < rounds; i++)
+    {
+        datagram.sequence = (uint16_t)i;
+        length = encodeReadingDatagram(datagram, buffer, sizeof(buffer));
+    }
+    double encodeSecs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    unsigned int valid = 0;
+    ReadingDatagram decoded;
+    start = std::chrono::steady_clock::now();
+    for (unsigned int i = 0; i < rounds; i++)
+    {
+        if (decodeReadingDatagram(buffer, length, decoded))
+            valid++;
+    }
+    double decodeSecs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    char message[128];
+    snprintf(message, sizeof(message), "%u bytes per datagram, encode: %.0f ns, decode: %.0f ns", (unsigned int)length,
+             encodeSecs / rounds * 1e9, decodeSecs / rounds * 1e9);
+    TEST_MESSAGE(message);
+    TEST_ASSERT_EQUAL(rounds, valid);
+}
+
+int main(int argc, char **argv)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_round_trip);
+    RUN_TEST(test_invalid_values_are_left_out);
+    RUN_TEST(test_long_names_and_many_probes_are_cut_off);
+    RUN_TEST(test_too_small_buffer);
+    RUN_TEST(test_every_flipped_bit_is_rejected);
+    RUN_TEST(test_newer_version_is_rejected);
+    RUN_TEST(test_truncated_and_padded_datagrams_are_rejected);
+    RUN_TEST(test_benchmark_encode_and_decode);
+    return UNITY_END();
+}
@@ -0,0 +1,182 @@
+#include <unity.h>
+
+#include <chrono>
+#include <stdio.h>
+
+#include "../SimulatedHal.h"
+#include "ReadingLog.h"
+
+// Appending to and replaying the reading log on a RAM image of the file system
+
+const time_t START_TIME = 1700000000;
+// Records per chunk of the CSV export of the web server
+const size_t RECORDS_PER_CHUNK = 16;
+
+SimulatedHal hal;
+
+static Sample sampleAt(uint32_t index)
+{
+    Sample sample;
+    sample.time = START_TIME + index * 60;
+    sample.temp = 20.0F + index % 100 / 10.0F;
+    sample.batteryStatus = 0.9F;
+
+    return sample;
+}
+
+static void appendSamples(uint32_t from, uint32_t count)
+{
+    for (uint32_t i = from; i < from + count; i++)
+        TEST_ASSERT_TRUE(appendReadingLog(hal, sampleAt(i)));
+}
+
+// Replays the whole log chunk by chunk like the export does and checks every record against its sample
+static void replay(uint32_t expectedFirst, uint32_t expectedCount)
+{
+    uint32_t sequence = 0;
+    uint32_t expected = expectedFirst;
+    LogRecord records[RECORDS_PER_CHUNK];
+    size_t count;
+    while ((count = readReadingLog(hal, sequence, records, RECORDS_PER_CHUNK)) > 0)
+    {
+        for (size_t i = 0; i < count; i++, expected++)
+        {
+            TEST_ASSERT_EQUAL(expected, records[i].sequence);
+            TEST_ASSERT_EQUAL(sampleAt(expected).time, records[i].time);
+            TEST_ASSERT_EQUAL_FLOAT(sampleAt(expected).temp, records[i].temp);
+        }
+    }
+
+    TEST_ASSERT_EQUAL(expectedFirst + expectedCount, expected);
+}
+
+void setUp(void)
+{
+    hal = SimulatedHal();
+}
+
+void tearDown(void)
+{
+}
+
+void test_round_trip_across_segments(void)
+{
+    TEST_ASSERT_TRUE(beginReadingLog(hal));
+    appendSamples(0, 3 * RECORDS_PER_LOG_SEGMENT + 10);
+
+    TEST_ASSERT_EQUAL(4, hal.files.size());
+    TEST_ASSERT_EQUAL(0, firstReadingLogSequence());
+    TEST_ASSERT_EQUAL(3 * RECORDS_PER_LOG_SEGMENT + 10, nextReadingLogSequence());
+    replay(0, 3 * RECORDS_PER_LOG_SEGMENT + 10);
+}
+
+void test_continues_after_a_restart(void)
+{
+    beginReadingLog(hal);
+    appendSamples(0, RECORDS_PER_LOG_SEGMENT + 5);
+
+    TEST_ASSERT_TRUE(beginReadingLog(hal));
+    TEST_ASSERT_EQUAL(RECORDS_PER_LOG_SEGMENT + 5, nextReadingLogSequence());
+    appendSamples(RECORDS_PER_LOG_SEGMENT + 5, 5);
+
+    TEST_ASSERT_EQUAL(2, hal.files.size());
+    replay(0, RECORDS_PER_LOG_SEGMENT + 10);
+}
+
+void test_oldest_segments_are_deleted(void)
+{
+    beginReadingLog(hal);
+    appendSamples(0, (MAX_LOG_SEGMENTS + 2) * RECORDS_PER_LOG_SEGMENT);
+
+    TEST_ASSERT_EQUAL(MAX_LOG_SEGMENTS, hal.files.size());
+    TEST_ASSERT_EQUAL(2 * RECORDS_PER_LOG_SEGMENT, firstReadingLogSequence());
+    replay(2 * RECORDS_PER_LOG_SEGMENT, MAX_LOG_SEGMENTS * RECORDS_PER_LOG_SEGMENT);
+}
+
+void test_corrupted_records_are_skipped(void)
+{
+    beginReadingLog(hal);
+    appendSamples(0, 20);
+    hal.files.begin()->second[5 * sizeof(LogRecord) + offsetof(LogRecord, temp)] ^= 0x01;
+
+    uint32_t sequence = 0;
+    LogRecord records[RECORDS_PER_CHUNK];
+    size_t count = readReadingLog(hal, sequence, records, RECORDS_PER_CHUNK);
+
+    // The chunk is filled up from behind the skipped record
+    TEST_ASSERT_EQUAL(RECORDS_PER_CHUNK, count);
+    TEST_ASSERT_EQUAL(RECORDS_PER_CHUNK + 1, sequence);
+    TEST_ASSERT_EQUAL(4, records[4].sequence);
+    TEST_ASSERT_EQUAL(6, records[5].sequence);
+}
+
+void test_cut_off_record_starts_a_new_segment(void)
+{
+    beginReadingLog(hal);
+    appendSamples(0, 10);
+
+    // Power lost in the middle of the last record
+    std::vector<uint8_t> &segment = hal.files.begin()->second;
+    segment.resize(segment.size() - sizeof(LogRecord) / 2);
+
+    beginReadingLog(hal);
+    TEST_ASSERT_EQUAL(9, nextReadingLogSequence());
+    appendSamples(9, 10);
+
+    TEST_ASSERT_EQUAL(2, hal.files.size());
+    replay(0, 19);
+}
+
+void test_segment_with_only_a_cut_off_record_is_replaced(void)
+{
+    beginReadingLog(hal);
+    appendSamples(0, RECORDS_PER_LOG_SEGMENT + 1);
+
+    std::vector<uint8_t> &segment = hal.files.rbegin()->second;
+    segment.resize(sizeof(LogRecord) / 2);
+
+    beginReadingLog(hal);
+    TEST_ASSERT_EQUAL(RECORDS_PER_LOG_SEGMENT, nextReadingLogSequence());
+    appendSamples(RECORDS_PER_LOG_SEGMENT, 10);
+
+    TEST_ASSERT_EQUAL(2, hal.files.size());
+    replay(0, RECORDS_PER_LOG_SEGMENT + 10);
+}
+
+void test_benchmark_append_and_replay(void)
+{
+    const uint32_t count = MAX_LOG_SEGMENTS * RECORDS_PER_LOG_SEGMENT;
+    beginReadingLog(hal);
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    appendSamples(0, count);
+    double appendSecs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    uint32_t appendOperations = hal.fileOperations;
+
+    hal.fileOperations = 0;
+    start = std::chrono::steady_clock::now();
+    replay(0, count);
+    double replaySecs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    // File operations are what costs on flash, every one of them walks LittleFS metadata
+    char message[160];
+    snprintf(message, sizeof(message), "Append: %.0f k records/s, %.2f file operations each", count / appendSecs / 1000,
+             (float)appendOperations / count);
+    TEST_MESSAGE(message);
+    snprintf(message, sizeof(message), "Replay in chunks of %u: %.0f k records/s, %.2f file operations per chunk",
+             (unsigned int)RECORDS_PER_CHUNK, count / replaySecs / 1000, (float)hal.fileOperations * RECORDS_PER_CHUNK / count);
+    TEST_MESSAGE(message);
+}
+
+int main(int argc, char **argv)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_round_trip_across_segments);
+    RUN_TEST(test_continues_after_a_restart);
+    RUN_TEST(test_oldest_segments_are_deleted);
+    RUN_TEST(test_corrupted_records_are_skipped);
+    RUN_TEST(test_cut_off_record_starts_a_new_segment);
+    RUN_TEST(test_segment_with_only_a_cut_off_record_is_replaced);
+    RUN_TEST(test_benchmark_append_and_replay);
+    return UNITY_END();
+}
@@ -0,0 +1,121 @@
+#include <unity.h>
+
+#include <atomic>
+#include <chrono>
+#include <stdio.h>
+#include <thread>
+#include <vector>
+
+#include "ReadingSnapshot.h"
+
+// The seqlock under a writer publishing as fast as it can and readers on other threads
+
+const uint32_t PUBLISHED_READINGS = 1000000;
+const unsigned int READER_THREADS = 3;
+
+// Every field is derived from the same counter, so a torn copy mixes values of different counters
+static Reading readingOf(uint32_t counter)
+{
+    Reading reading;
+    reading.temp = (float)counter;
+    reading.batteryStatus = (float)counter;
+    for (unsigned int i = 0; i < MAX_READING_PROBES; i++)
+        reading.probeTemps[i] = (float)counter;
+    reading.probeCount = counter % (MAX_READING_PROBES + 1);
+
+    return reading;
+}
+
+static bool isConsistent(const Reading &reading)
+{
+    uint32_t counter = (uint32_t)reading.temp;
+    if (reading.batteryStatus != reading.temp || reading.probeCount != counter % (MAX_READING_PROBES + 1))
+        return false;
+
+    for (unsigned int i = 0; i < MAX_READING_PROBES; i++)
+    {
+        if (reading.probeTemps[i] != reading.temp)
+            return false;
+    }
+
+    return true;
+}
+
+struct ReaderStats
+{
+    uint64_t reads;
+    uint64_t torn;
+    uint64_t backwards;
+};
+
+void setUp(void)
+{
+    publishReading(readingOf(0));
+}
+
+void tearDown(void)
+{
+}
+
+void test_reads_are_never_torn(void)
+{
+    std::atomic<bool> done(false);
+    std::vector<ReaderStats> stats(READER_THREADS);
+    std::vector<std::thread> readers;
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (unsigned int i = 0; i < READER_THREADS; i++)
+    {
+        readers.push_back(std::thread([&done, &stats, i]() {
+            ReaderStats &own = stats[i];
+            own.reads = own.torn = own.backwards = 0;
+            float previous = 0.0F;
+            while (!done.load(std::memory_order_relaxed))
+            {
+                Reading reading;
+                readReading(reading);
+                own.reads++;
+                if (!isConsistent(reading))
+                    own.torn++;
+                // A single publisher only moves forward
+                if (reading.temp < previous)
+                    own.backwards++;
+                previous = reading.temp;
+            }
+        }));
+    }
+
+    for (uint32_t counter = 1; counter <= PUBLISHED_READINGS; counter++)
+        publishReading(readingOf(counter));
+    done.store(true);
+    for (std::thread &reader : readers)
+        reader.join();
+    double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    ReaderStats total = {0, 0, 0};
+    for (const ReaderStats &own : stats)
+    {
+        total.reads += own.reads;
+        total.torn += own.torn;
+        total.backwards += own.backwards;
+    }
+
+    char message[160];
+    snprintf(message, sizeof(message), "%u publishes and %llu reads on %u threads in %.2f s",
+             (unsigned int)PUBLISHED_READINGS, (unsigned long long)total.reads, READER_THREADS, secs);
+    TEST_MESSAGE(message);
+    TEST_ASSERT_GREATER_THAN(0, total.reads);
+    TEST_ASSERT_EQUAL(0, total.torn);
+    TEST_ASSERT_EQUAL(0, total.backwards);
+
+    Reading last;
+    readReading(last);
+    TEST_ASSERT_EQUAL_FLOAT((float)PUBLISHED_READINGS, last.temp);
+}
+
+int main(int argc, char **argv)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_reads_are_never_torn);
+    return UNITY_END();
+}
@@ -0,0 +1,108 @@
+#include <unity.h>
+
+#include <string.h>
+
+#include "ReportQueue.h"
+
+// Order, capacity, backoff and the age limit of the queue of failed reports
+
+const time_t START_TIME = 1700000000;
+
+ReportQueue queue;
+
+void setUp(void)
+{
+    memset(&queue, 0, sizeof(queue));
+}
+
+void tearDown(void)
+{
+}
+
+void test_reports_come_out_in_order(void)
+{
+    enqueueReport(queue, REPORT_TARGET_TEMPERATURE, 21.5F, START_TIME);
+    enqueueReport(queue, REPORT_TARGET_BATTERY, 0.8F, START_TIME);
+    enqueueReport(queue, REPORT_TARGET_PROBES + 1, 19.0F, START_TIME + 60);
+
+    TEST_ASSERT_EQUAL(REPORT_TARGET_TEMPERATURE, peekReport(queue)->target);
+    popReport(queue);
+    TEST_ASSERT_EQUAL(REPORT_TARGET_BATTERY, peekReport(queue)->target);
+    popReport(queue);
+    TEST_ASSERT_EQUAL(REPORT_TARGET_PROBES + 1, peekReport(queue)->target);
+    TEST_ASSERT_EQUAL(START_TIME + 60, peekReport(queue)->time);
+    popReport(queue);
+    TEST_ASSERT_NULL(peekReport(queue));
+}
+
+void test_full_queue_drops_the_oldest(void)
+{
+    for (unsigned int i = 0; i < CAPACITY_REPORT_QUEUE; i++)
+        TEST_ASSERT_TRUE(enqueueReport(queue, REPORT_TARGET_TEMPERATURE, (float)i, START_TIME + i));
+
+    TEST_ASSERT_FALSE(enqueueReport(queue, REPORT_TARGET_TEMPERATURE, -1.0F, START_TIME + CAPACITY_REPORT_QUEUE));
+    TEST_ASSERT_EQUAL(CAPACITY_REPORT_QUEUE, queue.count);
+    TEST_ASSERT_EQUAL(1, queue.dropped);
+    TEST_ASSERT_EQUAL_FLOAT(1.0F, peekReport(queue)->value);
+}
+
+void test_backoff_doubles_up_to_the_limit(void)
+{
+    // Without jitter the random value in the middle of the range
+    TEST_ASSERT_EQUAL(MIN_SECS_REPORT_BACKOFF, reportBackoffSecs(1, MIN_SECS_REPORT_BACKOFF / 4));
+    TEST_ASSERT_EQUAL(2 * MIN_SECS_REPORT_BACKOFF, reportBackoffSecs(2, MIN_SECS_REPORT_BACKOFF / 2));
+    TEST_ASSERT_EQUAL(MAX_SECS_REPORT_BACKOFF, reportBackoffSecs(UINT8_MAX, MAX_SECS_REPORT_BACKOFF / 4));
+
+    for (uint32_t random = 0; random < 1000; random++)
+    {
+        uint32_t backoff = reportBackoffSecs(3, random * 7919);
+        TEST_ASSERT_GREATER_OR_EQUAL_UINT32(3 * MIN_SECS_REPORT_BACKOFF, backoff);
+        TEST_ASSERT_LESS_OR_EQUAL_UINT32(5 * MIN_SECS_REPORT_BACKOFF, backoff);
+    }
+}
+
+void test_retry_waits_for_the_backoff(void)
+{
+    enqueueReport(queue, REPORT_TARGET_TEMPERATURE, 21.5F, START_TIME);
+    registerReportFailure(queue, START_TIME, 0);
+
+    TEST_ASSERT_FALSE(isRetryDue(queue, START_TIME + 1));
+    TEST_ASSERT_TRUE(isRetryDue(queue, queue.nextRetry));
+
+    registerReportSuccess(queue);
+    TEST_ASSERT_EQUAL(0, queue.failures);
+    TEST_ASSERT_TRUE(isRetryDue(queue, START_TIME));
+}
+
+void test_stale_reports_are_dropped(void)
+{
+    enqueueReport(queue, REPORT_TARGET_TEMPERATURE, 20.0F, START_TIME);
+    enqueueReport(queue, REPORT_TARGET_BATTERY, 0.8F, START_TIME);
+    enqueueReport(queue, REPORT_TARGET_TEMPERATURE, 21.0F, START_TIME + 3600);
+
+    TEST_ASSERT_EQUAL(0, dropStaleReports(queue, START_TIME + MAX_SECS_REPORT_AGE));
+    TEST_ASSERT_EQUAL(2, dropStaleReports(queue, START_TIME + MAX_SECS_REPORT_AGE + 1));
+    TEST_ASSERT_EQUAL(1, queue.count);
+    TEST_ASSERT_EQUAL(2, queue.dropped);
+    TEST_ASSERT_EQUAL_FLOAT(21.0F, peekReport(queue)->value);
+}
+
+void test_clock_set_back_keeps_the_reports(void)
+{
+    enqueueReport(queue, REPORT_TARGET_TEMPERATURE, 20.0F, START_TIME);
+
+    TEST_ASSERT_EQUAL(0, dropStaleReports(queue, START_TIME - MAX_SECS_REPORT_AGE - 1));
+    TEST_ASSERT_EQUAL(1, queue.count);
+}
+
+int main(int argc, char **argv)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_reports_come_out_in_order);
+    RUN_TEST(test_full_queue_drops_the_oldest);
+    RUN_TEST(test_backoff_doubles_up_to_the_limit);
+    RUN_TEST(test_retry_waits_for_the_backoff);
+    RUN_TEST(test_stale_reports_are_dropped);
+    RUN_TEST(test_clock_set_back_keeps_the_reports);
+    return UNITY_END();
+}
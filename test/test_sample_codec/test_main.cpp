@@ -0,0 +1,205 @@
+#include <unity.h>
+
+#include <chrono>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "SampleCodec.h"
+
+// Round trips, the worst case size of a sample and the throughput of the sample codec
+
+const time_t START_TIME = 1700000000;
+// A sample as plain time_t and two floats, what the codec is compared against
+const size_t BYTES_RAW_SAMPLE = 4 + 4 + 4;
+
+EncodedSamples samples;
+
+static Sample sampleAt(time_t time, float temp, float batteryStatus)
+{
+    Sample sample;
+    sample.time = time;
+    sample.temp = temp;
+    sample.batteryStatus = batteryStatus;
+
+    return sample;
+}
+
+// Slowly drifting temperature with sensor noise, one sample a minute
+static Sample typicalSample(unsigned int index)
+{
+    float temp = 21.0F + 2.0F * sinf(index / 240.0F) + (rand() % 13 - 6) / 100.0F;
+    return sampleAt(START_TIME + index * 60, temp, 0.9F - index / 100000.0F);
+}
+
+// Every value as far from the previous one as the fields allow
+static Sample noisySample(unsigned int index)
+{
+    float temp = index % 2 == 0 ? 327.67F : -327.68F;
+    float batteryStatus = index % 2 == 0 ? 2.0F : -1.0F;
+    time_t time = index % 2 == 0 ? (time_t)0xFFFFFFFF : 0;
+    return sampleAt(time, temp, batteryStatus);
+}
+
+void setUp(void)
+{
+    memset(&samples, 0, sizeof(samples));
+    clearSamples(samples);
+    srand(1);
+}
+
+void tearDown(void)
+{
+}
+
+void test_round_trip_of_a_few_samples(void)
+{
+    Sample in[] = {sampleAt(START_TIME, 21.37F, 0.85F), sampleAt(START_TIME + 60, 21.31F, 0.849F),
+                   sampleAt(START_TIME + 125, -5.5F, 0.5F), sampleAt(START_TIME + 126, -127.0F, -1.0F)};
+    for (const Sample &sample : in)
+        encodeSample(samples, sample);
+
+    SampleReader reader;
+    Sample out;
+    beginDecoding(reader, samples);
+    for (const Sample &sample : in)
+    {
+        TEST_ASSERT_TRUE(decodeSample(reader, out));
+        TEST_ASSERT_EQUAL(sample.time, out.time);
+        TEST_ASSERT_FLOAT_WITHIN(0.005F, sample.temp, out.temp);
+        TEST_ASSERT_FLOAT_WITHIN(0.0006F, sample.batteryStatus, out.batteryStatus);
+    }
+    TEST_ASSERT_FALSE(decodeSample(reader, out));
+}
+
+void test_round_trip_keeps_the_newest_groups(void)
+{
+    const unsigned int count = 2000;
+    static Sample in[count];
+    for (unsigned int i = 0; i < count; i++)
+    {
+        in[i] = typicalSample(i);
+        encodeSample(samples, in[i]);
+    }
+
+    // The oldest groups were dropped as a whole, so the buffer still starts on a keyframe
+    TEST_ASSERT_LESS_THAN(count, samples.count);
+    TEST_ASSERT_EQUAL(0, (count - samples.count) % KEYFRAME_INTERVAL_SAMPLES);
+
+    SampleReader reader;
+    Sample out;
+    beginDecoding(reader, samples);
+    // Battery is stored in per mille, half a step plus the float error off at most
+    for (unsigned int i = count - samples.count; i < count; i++)
+    {
+        TEST_ASSERT_TRUE(decodeSample(reader, out));
+        TEST_ASSERT_EQUAL(in[i].time, out.time);
+        TEST_ASSERT_FLOAT_WITHIN(0.005F, in[i].temp, out.temp);
+        TEST_ASSERT_FLOAT_WITHIN(0.0006F, in[i].batteryStatus, out.batteryStatus);
+    }
+    TEST_ASSERT_FALSE(decodeSample(reader, out));
+}
+
+void test_out_of_range_values_are_clamped(void)
+{
+    encodeSample(samples, sampleAt(START_TIME, 1000.0F, 5.0F));
+    encodeSample(samples, sampleAt(START_TIME, -1000.0F, -5.0F));
+
+    SampleReader reader;
+    Sample out;
+    beginDecoding(reader, samples);
+    TEST_ASSERT_TRUE(decodeSample(reader, out));
+    TEST_ASSERT_FLOAT_WITHIN(0.005F, 327.67F, out.temp);
+    TEST_ASSERT_FLOAT_WITHIN(0.0005F, 2.0F, out.batteryStatus);
+    TEST_ASSERT_TRUE(decodeSample(reader, out));
+    TEST_ASSERT_FLOAT_WITHIN(0.005F, -327.68F, out.temp);
+    TEST_ASSERT_FLOAT_WITHIN(0.0005F, -1.0F, out.batteryStatus);
+}
+
+void test_worst_case_size_of_a_sample(void)
+{
+    uint16_t longest = 0;
+    for (unsigned int i = 0; i < 4 * KEYFRAME_INTERVAL_SAMPLES; i++)
+    {
+        uint16_t before = samples.length;
+        encodeSample(samples, noisySample(i));
+        if (samples.length - before > longest)
+            longest = samples.length - before;
+    }
+
+    char message[64];
+    snprintf(message, sizeof(message), "Longest sample: %u bytes", longest);
+    TEST_MESSAGE(message);
+    TEST_ASSERT_LESS_OR_EQUAL(MAX_BYTES_PER_SAMPLE, longest);
+
+    // Even then a full buffer holds the samples it promises
+    for (unsigned int i = 0; i < 1000; i++)
+        encodeSample(samples, noisySample(i));
+    TEST_ASSERT_GREATER_OR_EQUAL(CAPACITY_ENCODED_SAMPLES / MAX_BYTES_PER_SAMPLE - KEYFRAME_INTERVAL_SAMPLES, samples.count);
+}
+
+void test_typical_signal_is_several_times_smaller(void)
+{
+    unsigned int i = 0;
+    while (!isSamplesNearlyFull(samples, 1))
+        encodeSample(samples, typicalSample(i++));
+
+    float bytesPerSample = (float)samples.length / samples.count;
+    char message[96];
+    snprintf(message, sizeof(message), "%u samples in %u bytes, %.2f bytes per sample", samples.count, samples.length, bytesPerSample);
+    TEST_MESSAGE(message);
+    TEST_ASSERT_LESS_OR_EQUAL(BYTES_RAW_SAMPLE / 3.0F, bytesPerSample);
+}
+
+void test_benchmark_throughput(void)
+{
+    const unsigned int rounds = 2000;
+    static Sample in[CAPACITY_ENCODED_SAMPLES];
+    for (unsigned int i = 0; i < CAPACITY_ENCODED_SAMPLES; i++)
+        in[i] = typicalSample(i);
+
+    unsigned long encoded = 0;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (unsigned int round = 0; round < rounds; round++)
+    {
+        clearSamples(samples);
+        for (unsigned int i = 0; !isSamplesNearlyFull(samples, 1); i++, encoded++)
+            encodeSample(samples, in[i]);
+    }
+    double encodeSecs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    unsigned long decoded = 0;
+    float sum = 0.0F;
+    start = std::chrono::steady_clock::now();
+    for (unsigned int round = 0; round < rounds; round++)
+    {
+        SampleReader reader;
+        Sample out;
+        beginDecoding(reader, samples);
+        while (decodeSample(reader, out))
+        {
+            sum += out.temp;
+            decoded++;
+        }
+    }
+    double decodeSecs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    char message[128];
+    snprintf(message, sizeof(message), "Encode: %.1f M samples/s, decode: %.1f M samples/s (checksum %.0f)",
+             encoded / encodeSecs / 1e6, decoded / decodeSecs / 1e6, sum);
+    TEST_MESSAGE(message);
+    TEST_ASSERT_EQUAL(rounds * samples.count, decoded);
+}
+
+int main(int argc, char **argv)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_round_trip_of_a_few_samples);
+    RUN_TEST(test_round_trip_keeps_the_newest_groups);
+    RUN_TEST(test_out_of_range_values_are_clamped);
+    RUN_TEST(test_worst_case_size_of_a_sample);
+    RUN_TEST(test_typical_signal_is_several_times_smaller);
+    RUN_TEST(test_benchmark_throughput);
+    return UNITY_END();
+}
@@ -0,0 +1,141 @@
+#include <unity.h>
+
+#include <chrono>
+#include <stdio.h>
+#include <string.h>
+
+#include "../SimulatedHal.h"
+#include "SettingsStore.h"
+
+// Migrating the keys of older firmware and what loading one record saves over reading every key
+
+SimulatedHal hal;
+
+// Settings of a device that was set up with an older firmware, everything else is left at its default
+static void putLegacySettings(void)
+{
+    hal.putPreference(PREFS_NAME, ID_NAME, "garden");
+    hal.putPreference(PREFS_NAME, ID_ACTIVATE_REPORTING, true);
+    hal.putPreference(PREFS_NAME, ID_EDIT_ADDRESS, "http://collector/garden");
+    hal.putPreference(PREFS_NAME, ID_INTERVAL_SECS, (uint32_t)600);
+    hal.putPreference(PREFS_NAME, ID_PASSIVE, true);
+    hal.putPreference(PREFS_NAME, ID_DEADBAND_TEMP, 0.5F);
+    hal.putPreference(PREFS_NAME, ID_REPORTING_BACKEND, (uint32_t)REPORTING_BACKEND_MQTT);
+    hal.putPreference(PREFS_NAME, ID_MQTT_HOST, "broker");
+}
+
+void setUp(void)
+{
+    hal = SimulatedHal();
+}
+
+void tearDown(void)
+{
+}
+
+void test_defaults_of_a_new_device(void)
+{
+    SettingsRecord record;
+    TEST_ASSERT_EQUAL(0, loadSettingsRecord(hal, record));
+
+    loadLegacySettings(hal, "a1b2c3", record);
+    TEST_ASSERT_TRUE(isSettingsRecordValid(record));
+    TEST_ASSERT_EQUAL_STRING("a1b2c3", record.name);
+    TEST_ASSERT_EQUAL(1800, record.intervalSecs);
+    TEST_ASSERT_EQUAL(10, record.batchSize);
+    TEST_ASSERT_EQUAL(1883, record.mqttPort);
+    TEST_ASSERT_EQUAL_STRING("thermometer/a1b2c3/temperature", record.mqttTopicTemp);
+    TEST_ASSERT_EQUAL_STRING(DEFAULT_MULTICAST_GROUP, record.multicastGroup);
+    TEST_ASSERT_EQUAL(DEFAULT_MULTICAST_PORT, record.multicastPort);
+}
+
+void test_legacy_keys_are_migrated_once(void)
+{
+    putLegacySettings();
+
+    SettingsRecord record;
+    loadLegacySettings(hal, "a1b2c3", record);
+    TEST_ASSERT_EQUAL_STRING("garden", record.name);
+    TEST_ASSERT_TRUE(record.activateReporting);
+    TEST_ASSERT_EQUAL_STRING("http://collector/garden", record.editAddress);
+    TEST_ASSERT_EQUAL(600, record.intervalSecs);
+    TEST_ASSERT_TRUE(record.passive);
+    TEST_ASSERT_FLOAT_WITHIN(0.001F, 0.5F, record.deadbandTemp);
+    TEST_ASSERT_EQUAL(REPORTING_BACKEND_MQTT, record.reportingBackend);
+    TEST_ASSERT_EQUAL_STRING("broker", record.mqttHost);
+    TEST_ASSERT_EQUAL_STRING("thermometer/garden/battery", record.mqttTopicBattery);
+
+    TEST_ASSERT_TRUE(writeSettingsRecord(hal, record));
+    removeLegacySettings(hal);
+    TEST_ASSERT_EQUAL(1, hal.preferences[PREFS_NAME].size());
+
+    SettingsRecord loaded;
+    TEST_ASSERT_EQUAL(sizeof(SettingsRecord), loadSettingsRecord(hal, loaded));
+    TEST_ASSERT_EQUAL_MEMORY(&record, &loaded, sizeof(SettingsRecord));
+}
+
+void test_corrupted_record_is_not_loaded(void)
+{
+    SettingsRecord record;
+    loadLegacySettings(hal, "a1b2c3", record);
+    writeSettingsRecord(hal, record);
+    hal.preferences[PREFS_NAME][ID_SETTINGS_RECORD][4] ^= 0x01;
+
+    TEST_ASSERT_EQUAL(0, loadSettingsRecord(hal, record));
+}
+
+// On the device every lookup scans flash pages, which the simulated NVS time stands for. The host time only shows
+// the CPU work around it, for the record mostly its CRC.
+void test_benchmark_legacy_keys_against_the_record(void)
+{
+    const unsigned int rounds = 20000;
+    putLegacySettings();
+    SettingsRecord record;
+
+    hal.preferenceReads = 0;
+    uint64_t startUs = hal.nowUs;
+    loadLegacySettings(hal, "a1b2c3", record);
+    uint32_t legacyReads = hal.preferenceReads;
+    uint64_t legacyUs = hal.nowUs - startUs;
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (unsigned int i = 0; i < rounds; i++)
+        loadLegacySettings(hal, "a1b2c3", record);
+    double legacySecs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    writeSettingsRecord(hal, record);
+    removeLegacySettings(hal);
+
+    hal.preferenceReads = 0;
+    startUs = hal.nowUs;
+    TEST_ASSERT_EQUAL(sizeof(SettingsRecord), loadSettingsRecord(hal, record));
+    uint32_t recordReads = hal.preferenceReads;
+    uint64_t recordUs = hal.nowUs - startUs;
+
+    start = std::chrono::steady_clock::now();
+    for (unsigned int i = 0; i < rounds; i++)
+        loadSettingsRecord(hal, record);
+    double recordSecs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    char message[200];
+    snprintf(message, sizeof(message), "Keys: %u lookups, %u us simulated NVS, %.2f us host", (unsigned int)legacyReads,
+             (unsigned int)legacyUs, legacySecs / rounds * 1e6);
+    TEST_MESSAGE(message);
+    snprintf(message, sizeof(message), "Record: %u lookups, %u us simulated NVS, %.2f us host", (unsigned int)recordReads,
+             (unsigned int)recordUs, recordSecs / rounds * 1e6);
+    TEST_MESSAGE(message);
+
+    TEST_ASSERT_EQUAL(1, recordReads);
+    TEST_ASSERT_GREATER_THAN(20, legacyReads);
+    TEST_ASSERT_LESS_THAN(legacyUs, recordUs);
+}
+
+int main(int argc, char **argv)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_defaults_of_a_new_device);
+    RUN_TEST(test_legacy_keys_are_migrated_once);
+    RUN_TEST(test_corrupted_record_is_not_loaded);
+    RUN_TEST(test_benchmark_legacy_keys_against_the_record);
+    return UNITY_END();
+}
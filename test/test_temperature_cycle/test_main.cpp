@@ -0,0 +1,230 @@
+#include <unity.h>
+
+#include <stdio.h>
+
+#include "../SimulatedHal.h"
+#include "TemperatureCycle.h"
+
+// The conversion state machine against a simulated OneWire bus
+
+SimulatedHal hal;
+TemperatureCycle cycle;
+DeadbandSettings deadband;
+ReportedValues lastReported;
+ResolutionStats stats;
+
+// Steps like the sampling task does and returns the longest single step, the latency it adds to the loop
+static uint32_t runCycle(uint8_t resolution, TemperatureEvent *events = NULL, size_t maxEvents = 0)
+{
+    size_t eventCount = 0;
+    uint64_t start = hal.nowUs;
+    beginTemperatureCycle(cycle, hal, resolution);
+    uint32_t longestUs = hal.nowUs - start;
+
+    TemperatureEvent event = TEMPERATURE_EVENT_NONE;
+    while (event != TEMPERATURE_EVENT_FINISHED)
+    {
+        start = hal.nowUs;
+        event = stepTemperatureCycle(cycle, hal, deadband, lastReported, stats);
+        if (hal.nowUs - start > longestUs)
+            longestUs = hal.nowUs - start;
+
+        if (event != TEMPERATURE_EVENT_NONE && eventCount < maxEvents)
+            events[eventCount++] = event;
+        hal.delay(1);
+    }
+
+    return longestUs;
+}
+
+void setUp(void)
+{
+    hal = SimulatedHal();
+    memset(&cycle, 0, sizeof(cycle));
+    memset(&deadband, 0, sizeof(deadband));
+    memset(&lastReported, 0, sizeof(lastReported));
+    memset(&stats, 0, sizeof(stats));
+}
+
+void tearDown(void)
+{
+}
+
+void test_begin_returns_while_converting(void)
+{
+    hal.addProbe(20.5F);
+
+    beginTemperatureCycle(cycle, hal, RESOLUTION_HIGH);
+
+    TEST_ASSERT_EQUAL(TEMPERATURE_CONVERTING, cycle.state);
+    TEST_ASSERT_LESS_THAN(5, hal.millis());
+
+    hal.delay(100);
+    TEST_ASSERT_EQUAL(TEMPERATURE_EVENT_NONE, stepTemperatureCycle(cycle, hal, deadband, lastReported, stats));
+    TEST_ASSERT_EQUAL(TEMPERATURE_CONVERTING, cycle.state);
+}
+
+void test_collects_once_the_probe_is_done(void)
+{
+    hal.addProbe(20.5F, 0.5F);
+
+    runCycle(RESOLUTION_HIGH);
+
+    // Polled completion, not the nominal 750 ms
+    TEST_ASSERT_LESS_THAN(400, hal.millis());
+    TEST_ASSERT_EQUAL(TEMPERATURE_IDLE, cycle.state);
+    TEST_ASSERT_TRUE(cycle.allValid);
+    TEST_ASSERT_EQUAL(1, cycle.tries);
+    TEST_ASSERT_FLOAT_WITHIN(0.001F, 20.5F, cycle.temps[0]);
+}
+
+void test_collects_after_the_nominal_time_without_completion(void)
+{
+    hal.addProbe(20.5F, 0.5F);
+    hal.parasitePower = true;
+
+    runCycle(RESOLUTION_LOW);
+
+    TEST_ASSERT_TRUE(cycle.allValid);
+    TEST_ASSERT_GREATER_OR_EQUAL(93, hal.millis());
+    TEST_ASSERT_LESS_OR_EQUAL(93 + 25, hal.millis());
+}
+
+void test_retries_with_backoff_and_gives_up(void)
+{
+    hal.addProbe(20.5F);
+    hal.bus[0].connected = false;
+
+    TemperatureEvent events[MAX_TRIES_TEMPERATURE];
+    runCycle(RESOLUTION_LOW, events, MAX_TRIES_TEMPERATURE);
+
+    for (int i = 0; i < MAX_TRIES_TEMPERATURE - 1; i++)
+        TEST_ASSERT_EQUAL(TEMPERATURE_EVENT_RETRY, events[i]);
+    TEST_ASSERT_EQUAL(TEMPERATURE_EVENT_FINISHED, events[MAX_TRIES_TEMPERATURE - 1]);
+    TEST_ASSERT_FALSE(cycle.allValid);
+    TEST_ASSERT_EQUAL(MAX_TRIES_TEMPERATURE, cycle.tries);
+
+    // A missing probe does not hold the bus low, so every try ends right away and the waits of 100 to 400 ms remain
+    TEST_ASSERT_GREATER_OR_EQUAL(1000, hal.millis());
+    TEST_ASSERT_LESS_OR_EQUAL(1000 + MAX_TRIES_TEMPERATURE * 20, hal.millis());
+}
+
+void test_recovers_when_a_retry_succeeds(void)
+{
+    hal.addProbe(20.5F);
+    hal.bus[0].connected = false;
+
+    beginTemperatureCycle(cycle, hal, RESOLUTION_LOW);
+    hal.delay(94);
+    TEST_ASSERT_EQUAL(TEMPERATURE_EVENT_RETRY, stepTemperatureCycle(cycle, hal, deadband, lastReported, stats));
+    TEST_ASSERT_EQUAL(TEMPERATURE_RETRY_WAIT, cycle.state);
+
+    hal.bus[0].connected = true;
+    hal.delay(100);
+    TEST_ASSERT_EQUAL(TEMPERATURE_EVENT_NONE, stepTemperatureCycle(cycle, hal, deadband, lastReported, stats));
+    TEST_ASSERT_EQUAL(TEMPERATURE_CONVERTING, cycle.state);
+
+    hal.delay(94);
+    TEST_ASSERT_EQUAL(TEMPERATURE_EVENT_FINISHED, stepTemperatureCycle(cycle, hal, deadband, lastReported, stats));
+    TEST_ASSERT_TRUE(cycle.allValid);
+    TEST_ASSERT_EQUAL(2, cycle.tries);
+}
+
+void test_repeats_close_to_the_threshold_at_full_resolution(void)
+{
+    hal.addProbe(21.4F);
+    deadband.active = true;
+    deadband.thresholdTemp = 0.5F;
+    deadband.maxSilenceSecs = 3600;
+    lastReported.tempValid = true;
+    lastReported.temp = 20.8F;
+
+    TemperatureEvent events[2];
+    runCycle(RESOLUTION_LOW, events, 2);
+
+    TEST_ASSERT_EQUAL(TEMPERATURE_EVENT_REPEAT, events[0]);
+    TEST_ASSERT_EQUAL(TEMPERATURE_EVENT_FINISHED, events[1]);
+    TEST_ASSERT_EQUAL(RESOLUTION_HIGH, cycle.resolution);
+    TEST_ASSERT_EQUAL(RESOLUTION_LOW, cycle.cycleResolution);
+    TEST_ASSERT_FLOAT_WITHIN(0.0625F, 21.4F, cycle.temps[0]);
+}
+
+void test_reads_all_probes_after_one_conversion(void)
+{
+    hal.addProbe(18.0F, 0.6F);
+    hal.addProbe(19.0F, 0.8F);
+    hal.addProbe(20.0F, 0.7F);
+
+    runCycle(RESOLUTION_HIGH);
+
+    TEST_ASSERT_TRUE(cycle.allValid);
+    TEST_ASSERT_EQUAL(3, cycle.probeCount);
+    TEST_ASSERT_FLOAT_WITHIN(0.001F, 18.0F, cycle.temps[0]);
+    TEST_ASSERT_FLOAT_WITHIN(0.001F, 19.0F, cycle.temps[1]);
+    TEST_ASSERT_FLOAT_WITHIN(0.001F, 20.0F, cycle.temps[2]);
+
+    // The slowest probe sets the window, not the sum of them
+    TEST_ASSERT_LESS_THAN(650, hal.millis());
+}
+
+void test_one_missing_probe_fails_the_try(void)
+{
+    hal.addProbe(18.0F);
+    hal.addProbe(19.0F);
+    hal.bus[1].connected = false;
+
+    beginTemperatureCycle(cycle, hal, RESOLUTION_LOW);
+    hal.delay(94);
+
+    TEST_ASSERT_EQUAL(TEMPERATURE_EVENT_RETRY, stepTemperatureCycle(cycle, hal, deadband, lastReported, stats));
+    TEST_ASSERT_FLOAT_WITHIN(0.001F, 18.0F, cycle.temps[0]);
+    TEST_ASSERT_EQUAL_FLOAT(TEMP_DISCONNECTED, cycle.temps[1]);
+}
+
+void test_worst_case_loop_latency(void)
+{
+    for (unsigned int i = 0; i < MAX_READING_PROBES; i++)
+        hal.addProbe(20.0F + i);
+    hal.bus[MAX_READING_PROBES - 1].connected = false;
+
+    uint32_t longestUs = runCycle(RESOLUTION_HIGH);
+
+    // Reading every probe by address is the longest step, compared to 750 ms and more of a blocking conversion
+    uint32_t readAllUs = MAX_READING_PROBES * (US_ONEWIRE_RESET + 19 * US_ONEWIRE_BYTE);
+    char message[96];
+    snprintf(message, sizeof(message), "Longest step with %u probes: %u us", MAX_READING_PROBES, longestUs);
+    TEST_MESSAGE(message);
+    TEST_ASSERT_LESS_OR_EQUAL(readAllUs + 1000, longestUs);
+}
+
+void test_only_lowered_cycles_count_as_saved(void)
+{
+    hal.addProbe(20.0F, 0.8F);
+
+    runCycle(RESOLUTION_HIGH);
+    TEST_ASSERT_EQUAL(0, stats.lastSavedMs);
+    TEST_ASSERT_GREATER_OR_EQUAL(600, stats.highConversionMs);
+    TEST_ASSERT_LESS_OR_EQUAL(610, stats.highConversionMs);
+
+    // Compared to the 600 ms measured above, not to the nominal 750 ms
+    runCycle(RESOLUTION_LOW);
+    TEST_ASSERT_GREATER_OR_EQUAL(600 - 80, stats.lastSavedMs);
+    TEST_ASSERT_LESS_OR_EQUAL(600 - 70, stats.lastSavedMs);
+    TEST_ASSERT_EQUAL(2, stats.cycles);
+}
+
+int main(int argc, char **argv)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_begin_returns_while_converting);
+    RUN_TEST(test_collects_once_the_probe_is_done);
+    RUN_TEST(test_collects_after_the_nominal_time_without_completion);
+    RUN_TEST(test_retries_with_backoff_and_gives_up);
+    RUN_TEST(test_recovers_when_a_retry_succeeds);
+    RUN_TEST(test_repeats_close_to_the_threshold_at_full_resolution);
+    RUN_TEST(test_reads_all_probes_after_one_conversion);
+    RUN_TEST(test_one_missing_probe_fails_the_try);
+    RUN_TEST(test_worst_case_loop_latency);
+    RUN_TEST(test_only_lowered_cycles_count_as_saved);
+    return UNITY_END();
+}